@@ -39,12 +39,37 @@
 
 // 基础实现
 #include "rknn_cpp/base/base_model_impl.h"
+#include "rknn_cpp/base/memory_manager.h"
+#include "rknn_cpp/base/scratch_group.h"
+#include "rknn_cpp/base/npu_scheduler.h"
+#include "rknn_cpp/base/model_loader.h"
 
 // 具体模型实现
 #include "rknn_cpp/models/resnet_model.h"
 #include "rknn_cpp/models/yolov3_model.h"
 #include "rknn_cpp/models/custom_model.h"
 
+// 工具与推理流水线
+#include "rknn_cpp/utils/box_utils.h"
+#include "rknn_cpp/utils/metrics.h"
+#include "rknn_cpp/utils/tracer.h"
+#include "rknn_cpp/utils/layer_profiler.h"
+#include "rknn_cpp/utils/model_inspector.h"
+#include "rknn_cpp/utils/frame_diff.h"
+#include "rknn_cpp/utils/image_decode.h"
+#include "rknn_cpp/utils/result_serializer.h"
+#include "rknn_cpp/pipeline/tiled_detector.h"
+#include "rknn_cpp/pipeline/cascade.h"
+#include "rknn_cpp/pipeline/change_gate.h"
+#include "rknn_cpp/pipeline/tracker.h"
+#include "rknn_cpp/pipeline/batch_runner.h"
+
+// 进程间通信
+#include "rknn_cpp/ipc/shm_ring.h"
+#include "rknn_cpp/ipc/inference_protocol.h"
+#include "rknn_cpp/ipc/inference_server.h"
+#include "rknn_cpp/ipc/remote_model.h"
+
 /**
  * @namespace rknn_cpp
  * @brief RKNN C++ 推理库命名空间
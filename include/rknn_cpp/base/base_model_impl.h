@@ -1,13 +1,23 @@
 #pragma once
 #include "rknn_cpp/imodel.h"
+#include "rknn_cpp/utils/tensor_convert.h"
+#include "rknn_cpp/utils/aligned_buffer.h"
+#include "rknn_cpp/utils/metrics.h"
+#include "rknn_cpp/utils/tracer.h"
+#include "rknn_cpp/utils/layer_profiler.h"
+#include "rknn_cpp/base/npu_scheduler.h"
 #include "rknn_api.h"
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <opencv2/opencv.hpp>
 
 namespace rknn_cpp
 {
 
+class ScratchGroup;
+
 class BaseModelImpl : public IModel
 {
    public:
@@ -16,37 +26,93 @@ class BaseModelImpl : public IModel
 
     // 实现IModel接口
     bool initialize(const ModelConfig& config = {}) override final;
-    InferenceResult predict(const cv::Mat& image);
+    std::future<bool> initializeAsync(const ModelConfig& config = {}) override final;
+    InferenceResult predict(const cv::Mat& image) override;
+    InferenceResult predict(const cv::Mat& frame, const cv::Rect& roi) override;
+    InferenceResult predictTensors(const std::vector<InputTensor>& inputs) override;
+    InferenceResult predictEncoded(const uint8_t* data, size_t size) override;
+    InferenceResult predictFile(const std::string& path) override;
     void release() override;
+    std::vector<LayerProfile> getLayerProfile() const override;
+    void resetLayerProfile() override;
+    ModelMemoryUsage getMemoryUsage() const override;
     bool isInitialized() const override;
     int getModelWidth() const override;
     int getModelHeight() const override;
     int getModelChannels() const override;
+    cv::Size getMaxInputSize() const override;
     int getOriginalWidth() const { return original_width_; }
     int getOriginalHeight() const { return original_height_; }
+    // 当前帧推理区域在整帧中的偏移，整帧推理时为(0, 0)
+    cv::Point getRoiOffset() const { return roi_offset_; }
+
+    // 供MemoryManager使用：空闲时释放运行时资源并保留配置，下次推理时重新初始化
+    bool tryEvict();
+    bool isEvicted() const { return evicted_; }
+    // 最近一次推理的时间戳，用于选择最久未使用的模型
+    int64_t getLastUsed() const { return last_used_.load(std::memory_order_relaxed); }
+
+    // 初始化预热（warmup_runs）测得的首次推理与稳态推理耗时，未预热时为0
+    double getColdLatencyMs() const { return cold_latency_ms_; }
+    double getWarmLatencyMs() const { return warm_latency_ms_; }
 
    protected:
     // 子类需要实现的抽象方法
     virtual bool setupModel(const ModelConfig& config) = 0;
     virtual bool preprocessImage(const cv::Mat& src_img, cv::Mat& dst_img) = 0;              // 新增cv::Mat重载
     virtual InferenceResult postprocessOutputs(rknn_output* outputs, int output_count) = 0;  // 更新返回类型
+    // 张量级推理不经过preprocessImage，子类在此重置依赖预处理的状态（如letterbox参数）
+    virtual void resetPreprocessState() {}
 
     // 为子类提供的工具方法
-    bool loadRKNNModel(const std::string& model_path);
+    bool loadRKNNModel(const std::string& model_path, uint32_t init_flags = 0);
     bool runRKNNInference(const cv::Mat& input_img);  // 新增cv::Mat重载
+    bool runRKNNInference(const std::vector<InputTensor>& inputs);
+    bool setInputTensors(const std::vector<InputTensor>& inputs);
     void dumpTensorAttrs() const;
 
+    // 动态shape模型支持：按输入图像长宽比选择候选shape，减少letterbox填充
+    bool queryDynamicShapes(const ModelConfig& config);
+    bool selectInputShape(int src_width, int src_height);
+    bool applyInputShape(int shape_index);
+    bool isDynamicShape() const { return !dynamic_shapes_.empty(); }
+    const std::vector<cv::Size>& getDynamicShapes() const { return dynamic_shapes_; }
+
+    // 原生布局输入：CPU侧按模型量化参数量化并排布，以pass_through方式送入NPU
+    bool setupNativeInput(const ModelConfig& config);
+    bool queryNativeInputAttrs(bool current_shape);
+    bool isNativeInput() const { return native_input_enabled_; }
+
     // 为子类提供的便利方法 - 创建结果对象
     InferenceResult createDetectionResult(const DetectionResults& detections) const;
     InferenceResult createClassificationResult(const ClassificationResults& classifications) const;
     InferenceResult createEmptyResult() const;
 
+    // 配置解析帮助方法
+    static int getConfigInt(const ModelConfig& config, const std::string& key, int default_value);
+    static bool getConfigBool(const ModelConfig& config, const std::string& key, bool default_value);
+    static std::vector<float> getConfigFloatList(const ModelConfig& config, const std::string& key, size_t count,
+                                                 float default_value);
+
     // 为子类提供的图像处理帮助方法
     bool standardPreprocess(const cv::Mat& src_img, cv::Mat& dst_img) const;  // 新增cv::Mat重载
 
     bool letterboxPreprocess(const cv::Mat& src_img, cv::Mat& dst_img,
                              unsigned char bg_color = 114) const;  // 新增cv::Mat重载
 
+    /**
+     * @brief 读取输出张量中的元素并转换为float
+     * 输出以模型原始数据类型返回（不使用want_float），后处理只转换实际读取的元素
+     * @param output 输出缓冲区
+     * @param index 输出序号
+     * @param offset 起始元素偏移
+     * @param count 读取的元素数
+     * @param stride 相邻两个读取元素的间隔（元素数），1表示连续
+     * @param dst 目标float数组，至少count个元素
+     */
+    bool readOutputAsFloat(const rknn_output& output, int index, size_t offset, size_t count, size_t stride,
+                           float* dst) const;
+
     // 为子类提供的模型属性访问
     bool isQuantized() const { return is_quant_; }
     const std::vector<rknn_tensor_attr>& getInputAttrs() const { return input_attrs_; }
@@ -54,6 +120,26 @@ class BaseModelImpl : public IModel
     rknn_context getRKNNContext() const { return rknn_ctx_; }
 
    private:
+    // 调用方持有run_mutex_
+    bool initializeLocked(const ModelConfig& config);
+    bool initializeContext(const ModelConfig& config);
+    void releaseResources();
+    bool ensureLoaded();
+    void queryMemoryUsage();
+    static uint32_t getInitFlags(const ModelConfig& config);
+    bool setupInternalMemory(const ModelConfig& config, uint32_t init_flags);
+    bool runAndFetchOutputs();
+    bool warmup(int runs);
+    InferenceResult runPipeline(const cv::Mat& frame, const cv::Rect& roi, std::chrono::steady_clock::time_point start);
+    InferenceResult runTensorPipeline(const std::vector<InputTensor>& inputs,
+                                      std::chrono::steady_clock::time_point start);
+    void collectLayerPerf();
+    void updateModelInputDims();
+    bool allocateOutputBuffers();
+    InferenceResult createFailedResult() const;
+    void recordMetrics(const InferenceResult& result, double preprocess_ms, double inference_ms,
+                       double postprocess_ms) const;
+
     rknn_context rknn_ctx_;
     rknn_input_output_num io_num_;
     std::vector<rknn_tensor_attr> input_attrs_;
@@ -64,11 +150,66 @@ class BaseModelImpl : public IModel
     int model_channels_;
     int original_width_;   // 原始输入图像宽度
     int original_height_;  // 原始输入图像高度
-    bool initialized_;
+    cv::Point roi_offset_;  // ROI推理时区域左上角在整帧中的位置
+    std::atomic<bool> initialized_;
     bool is_quant_;
 
-    // 输出缓冲区
+    // 动态shape信息
+    std::vector<rknn_input_range> input_ranges_;
+    std::vector<cv::Size> dynamic_shapes_;
+    int current_shape_index_;
+    // 初始化时缓存，不随逐帧选择的shape变化；淘汰后保留（模型文件不变）
+    cv::Size max_input_size_;
+    bool dynamic_shape_enabled_;
+
+    // 输入缓冲区：校验通过后复用，仅在输入描述变化时重新校验
+    std::vector<rknn_input> inputs_;
+    std::vector<int> input_binding_;  // bound_inputs_[i] 对应的模型输入序号
+    std::vector<InputTensor> bound_inputs_;
+    std::vector<InputTensor> image_input_;
+
+    // 原生布局输入
+    std::vector<rknn_tensor_attr> native_input_attrs_;
+    bool native_input_enabled_;
+    InputQuantParams native_quant_;
+    AlignedBuffer native_input_buffer_;
+
+    // 输出缓冲区：按output_attrs_预分配并对齐，以is_prealloc方式交给运行时写入
     std::vector<rknn_output> outputs_;
+    std::vector<AlignedBuffer> output_buffers_;
+
+    // 逐层性能分析（enable_profiling）
+    bool profiling_enabled_;
+    LayerProfiler layer_profiler_;
+    std::vector<LayerPerf> layer_perf_;
+
+    // 外部分配的中间层内存（enable_sram），sram_bytes_为其中实际位于SRAM的部分
+    rknn_tensor_mem* internal_mem_;
+    size_t sram_bytes_;
+    // 共享中间层内存的分组（scratch_group），为空表示独占
+    std::shared_ptr<ScratchGroup> scratch_group_;
+
+    // 内存预算：淘汰后按config_重新初始化，run_mutex_保证不会淘汰正在推理的模型
+    ModelConfig config_;
+    ModelMemoryUsage memory_usage_;
+    std::atomic<bool> evicted_;
+    mutable std::mutex run_mutex_;
+    std::atomic<int64_t> last_used_;
+
+    // NPU调度（use_scheduler）：按优先级和截止时间排队，request_start_为当前请求的开始时间
+    bool use_scheduler_;
+    NpuPriority npu_priority_;
+    int deadline_ms_;
+    std::chrono::steady_clock::time_point request_start_;
+
+    // 预热（warmup_runs）：预热期间不记录指标
+    bool warming_up_;
+    int warmup_runs_;
+    double cold_latency_ms_;
+    double warm_latency_ms_;
+
+    // 运行指标（进程级注册表持有，可为空）
+    ModelMetrics* metrics_;
 
     // 预处理缓冲区
     cv::Mat preprocess_buffer_;
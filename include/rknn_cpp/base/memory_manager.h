@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+class BaseModelImpl;
+
+// 单个已登记模型的内存记账
+struct MemoryAccount
+{
+    std::string model_name;
+    size_t bytes;
+    size_t sram_bytes;  // 授予的SRAM配额
+    bool loaded;        // false表示正在加载（仅有预留）
+};
+
+/**
+ * @brief 进程级模型内存预算
+ * 模型加载前按预估大小预留，加载完成后按实际占用记账；超出预算时淘汰最久未使用的空闲模型
+ * （被淘汰的模型在下次推理时重新初始化），仍无法满足时加载失败。预算为0表示不限制。
+ */
+class MemoryManager
+{
+   public:
+    static MemoryManager& instance();
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+    size_t getUsedBytes() const;
+
+    // 加载前预留bytes，必要时淘汰其他空闲模型
+    bool reserve(BaseModelImpl* model, size_t bytes);
+    // 加载完成后以实际占用替换预留
+    bool commit(BaseModelImpl* model, size_t bytes);
+    void unregister(BaseModelImpl* model);
+
+    // SRAM配额：bytes不超过模型配额（quota为0时不限）且不超过剩余SRAM时整体授予，否则返回false（使用DRAM）
+    // 配额随模型登记一起释放
+    bool acquireSram(BaseModelImpl* model, size_t bytes, size_t quota, size_t total_sram);
+
+    // 不属于单个模型的共享内存（如ScratchGroup的中间层arena），计入预算。
+    // 增长前用reserveSharedBytes预留（与模型加载一样必要时淘汰空闲模型，仍放不下时返回false）；
+    // addSharedBytes无锁更新，不检查预算，用于释放/缩小及修正预留，可在淘汰过程中（releaseResources）调用
+    bool reserveSharedBytes(size_t bytes);
+    void addSharedBytes(int64_t delta);
+    size_t getSharedBytes() const;
+
+    std::vector<MemoryAccount> getAccounts() const;
+    void printSummary() const;
+
+   private:
+    struct Entry
+    {
+        BaseModelImpl* model;
+        MemoryAccount account;
+    };
+
+    MemoryManager() = default;
+    Entry* findLocked(BaseModelImpl* model);
+    size_t usedLocked(const BaseModelImpl* exclude) const;
+    bool makeRoomLocked(BaseModelImpl* requester, size_t bytes);
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    size_t budget_ = 0;
+    std::atomic<int64_t> shared_bytes_{0};
+};
+
+}  // namespace rknn_cpp
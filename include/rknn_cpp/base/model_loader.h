@@ -0,0 +1,84 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+enum class ModelLoadState
+{
+    PENDING,
+    LOADING,
+    READY,
+    FAILED
+};
+
+// 单个模型的加载状态，供服务就绪检查按模型上报
+struct ModelLoadStatus
+{
+    std::string name;
+    ModelLoadState state = ModelLoadState::PENDING;
+    double load_ms = 0.0;  // initialize耗时，仅READY/FAILED时有效
+};
+
+/**
+ * @brief 并行初始化一组模型
+ * 按add顺序分配给最多max_parallel个加载线程，各模型的文件读取与其他模型的rknn_init重叠进行；
+ * 启动时先对全部模型文件发出预读，排在后面的模型开始加载时文件通常已在页缓存中。
+ * 每个模型加载完成即回调，无需等待整组完成即可开始使用已就绪的模型。
+ */
+class ModelGroupLoader
+{
+   public:
+    using ReadyCallback = std::function<void(const std::string& name, bool success)>;
+
+    // max_parallel为0时使用CPU核数
+    explicit ModelGroupLoader(int max_parallel = 0);
+    ~ModelGroupLoader();
+
+    ModelGroupLoader(const ModelGroupLoader&) = delete;
+    ModelGroupLoader& operator=(const ModelGroupLoader&) = delete;
+
+    // 须在start前调用；model由调用方持有，加载期间保持有效
+    void add(const std::string& name, IModel* model, const ModelConfig& config);
+    void setReadyCallback(ReadyCallback callback);
+
+    void start();
+    // 等待全部模型加载结束，全部成功时返回true；尚未start时立即返回false
+    bool waitAll();
+    // 等待指定模型，超时、加载失败或尚未start时返回false；timeout_ms为负数时一直等待
+    bool waitFor(const std::string& name, int timeout_ms = -1);
+
+    bool isReady(const std::string& name) const;
+    std::vector<ModelLoadStatus> getStatus() const;
+    void printSummary() const;
+
+   private:
+    struct Item
+    {
+        IModel* model;
+        ModelConfig config;
+        ModelLoadStatus status;
+    };
+
+    void workerLoop();
+    void prefetchFiles() const;
+    const Item* findLocked(const std::string& name) const;
+
+    int max_parallel_;
+    std::vector<Item> items_;
+    size_t next_item_ = 0;
+    size_t finished_ = 0;
+    bool started_ = false;
+    ReadyCallback callback_;
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+}  // namespace rknn_cpp
@@ -0,0 +1,108 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+class BaseModelImpl;
+
+// 模型优先级，数值越小越优先；同时映射为rknn_init的RKNN_FLAG_PRIOR_*
+enum class NpuPriority
+{
+    HIGH = 0,
+    MEDIUM = 1,
+    LOW = 2
+};
+
+// 单个模型的排队统计
+struct NpuQueueStats
+{
+    std::string model_name;
+    NpuPriority priority = NpuPriority::MEDIUM;
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t dropped = 0;        // 在到达NPU前已错过截止时间而丢弃的请求
+    double total_wait_us = 0.0;  // 排队延迟（acquire到获得NPU）
+    double max_wait_us = 0.0;
+    double total_run_us = 0.0;  // 占用NPU的时间
+
+    double avgWaitUs() const { return submitted > dropped ? total_wait_us / (submitted - dropped) : 0.0; }
+    double avgRunUs() const { return completed > 0 ? total_run_us / completed : 0.0; }
+};
+
+/**
+ * @brief 进程级NPU调度器
+ * 启用调度的模型在rknn_run前向调度器申请NPU，请求先按优先级、再按截止时间（EDF）排序，
+ * 同一时刻最多max_concurrent个请求在NPU上运行；等待中已过截止时间的请求直接丢弃，不再占用NPU。
+ */
+class NpuScheduler
+{
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    static NpuScheduler& instance();
+
+    // 同时运行的请求数，默认1（严格串行）；多核NPU可适当调大
+    void setMaxConcurrent(int count);
+    int getMaxConcurrent() const;
+
+    // 阻塞直到获得NPU，返回false表示截止时间已过（请求被丢弃）。deadline为Clock::time_point::max()表示不限
+    bool acquire(BaseModelImpl* model, const std::string& model_name, NpuPriority priority,
+                 Clock::time_point deadline);
+    // 运行结束后归还NPU
+    void release(BaseModelImpl* model);
+    void unregister(BaseModelImpl* model);
+
+    std::vector<NpuQueueStats> getStats() const;
+    void printSummary() const;
+
+    static NpuPriority parsePriority(const std::string& value);
+    static const char* priorityName(NpuPriority priority);
+
+   private:
+    struct Request
+    {
+        int priority;
+        Clock::time_point deadline;
+        uint64_t seq;
+
+        bool operator<(const Request& other) const
+        {
+            if (priority != other.priority)
+            {
+                return priority < other.priority;
+            }
+            if (deadline != other.deadline)
+            {
+                return deadline < other.deadline;
+            }
+            return seq < other.seq;
+        }
+    };
+
+    struct Entry
+    {
+        BaseModelImpl* model;
+        NpuQueueStats stats;
+        Clock::time_point run_start;
+    };
+
+    NpuScheduler() = default;
+    Entry& entryLocked(BaseModelImpl* model, const std::string& model_name, NpuPriority priority);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::set<Request> pending_;
+    std::vector<Entry> entries_;
+    uint64_t next_seq_ = 0;
+    int running_ = 0;
+    int max_concurrent_ = 1;
+};
+
+}  // namespace rknn_cpp
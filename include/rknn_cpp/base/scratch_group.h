@@ -0,0 +1,57 @@
+#pragma once
+#include "rknn_api.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief 共享中间层内存的模型分组（config: scratch_group）
+ * 同组模型以RKNN_FLAG_INTERNAL_ALLOC_OUTSIDE初始化，共用一块按组内最大模型分配的中间层内存，
+ * 该内存记入MemoryManager的共享部分，增长时与模型加载一样受预算限制。组内推理由runMutex()互斥。
+ * 适用于不会同时运行的模型，如同一线程上的检测+分类。
+ */
+class ScratchGroup
+{
+   public:
+    static std::shared_ptr<ScratchGroup> get(const std::string& name);
+    ~ScratchGroup();
+
+    // 加入分组；internal_size超过当前arena时先向MemoryManager预留增量，再重新分配并重新绑定所有成员
+    bool join(rknn_context ctx, size_t internal_size);
+    /**
+     * @brief 离开分组，须在rknn_destroy(ctx)之前调用；arena由该ctx创建时改由其他成员重新分配
+     * @return false表示重新分配失败，其余成员仍绑定在该ctx创建的arena上：ctx交由分组保留，
+     *         调用方不得销毁，分组在之后重新分配成功或最后一个成员离开时销毁它
+     */
+    bool leave(rknn_context ctx);
+
+    std::mutex& runMutex() { return mutex_; }
+    const std::string& getName() const { return name_; }
+    size_t getArenaSize() const;
+    bool isArenaOwner(rknn_context ctx) const;
+
+   private:
+    struct Member
+    {
+        rknn_context ctx;
+        size_t internal_size;
+    };
+
+    explicit ScratchGroup(const std::string& name) : name_(name) {}
+    // reserved为已通过reserveSharedBytes预留的字节数，记账时从差值中扣除
+    bool rebuildLocked(size_t size, size_t reserved = 0);
+
+    std::string name_;
+    mutable std::mutex mutex_;  // 组内推理互斥，同时保护成员列表与arena
+    std::vector<Member> members_;
+    rknn_tensor_mem* arena_ = nullptr;
+    rknn_context arena_owner_ = 0;
+    size_t arena_size_ = 0;
+    rknn_context retired_owner_ = 0;  // 已离开但仍持有arena的ctx，见leave
+};
+
+}  // namespace rknn_cpp
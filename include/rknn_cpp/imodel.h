@@ -3,6 +3,7 @@
 #include <any>
 #include "rknn_cpp/types.h"
 #include <unordered_map>
+#include <future>
 #include <opencv2/opencv.hpp>
 namespace rknn_cpp
 {
@@ -16,9 +17,25 @@ class IModel
 
     // 核心接口
     virtual bool initialize(const ModelConfig& config) = 0;
+    // 在后台线程中初始化，future就绪前不得调用其他接口
+    virtual std::future<bool> initializeAsync(const ModelConfig& config) = 0;
     virtual InferenceResult predict(const cv::Mat& image) = 0;
+    // 仅对image中的roi区域推理，结果坐标为整帧坐标
+    virtual InferenceResult predict(const cv::Mat& image, const cv::Rect& roi) = 0;
+    // 张量级推理：跳过图像预处理，直接设置模型的全部输入
+    virtual InferenceResult predictTensors(const std::vector<InputTensor>& inputs) = 0;
+    // 编码图像推理（JPEG/PNG等）：JPEG在解码时按模型输入尺寸以DCT缩放缩小，结果坐标为原图坐标
+    virtual InferenceResult predictEncoded(const uint8_t* data, size_t size) = 0;
+    virtual InferenceResult predictFile(const std::string& path) = 0;
     virtual void release() = 0;
 
+    // 逐层性能分析：需以enable_profiling初始化，返回按总耗时降序的算子统计
+    virtual std::vector<LayerProfile> getLayerProfile() const = 0;
+    virtual void resetLayerProfile() = 0;
+
+    // 模型内存占用（权重、中间层、输入输出、主机侧缓冲区）
+    virtual ModelMemoryUsage getMemoryUsage() const = 0;
+
     // 信息获取接口
     virtual ModelTask getTaskType() const = 0;
     virtual std::string getModelName() const = 0;
@@ -28,5 +45,7 @@ class IModel
     virtual int getModelWidth() const = 0;
     virtual int getModelHeight() const = 0;
     virtual int getModelChannels() const = 0;
+    // 输入尺寸上限：动态shape模型为各候选shape的最大宽高，静态模型即输入尺寸；编码图像按此尺寸缩小解码
+    virtual cv::Size getMaxInputSize() const = 0;
 };
 }  // namespace rknn_cpp
\ No newline at end of file
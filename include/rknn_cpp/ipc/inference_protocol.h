@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace rknn_cpp
+{
+
+/**
+ * 本地推理服务协议（UNIX域SOCK_SEQPACKET，一条消息为一个请求或响应）：
+ *   请求：IpcRequest；图像或编码数据位于客户端创建的共享内存（memfd）的data_offset处，
+ *         共享内存的fd仅在首次使用或扩容时通过SCM_RIGHTS随请求传递一次（IPC_FLAG_NEW_SHM），
+ *         客户端须对memfd设置F_SEAL_SHRINK
+ *   响应：IpcResponse + payload
+ *         PREDICT：二进制结果记录（serializeBinary）+ 每个条目的类别名称（u16长度 + 字节），
+ *                  级联分类条目的名称排在检测名称之后
+ *         INFO：模型名称
+ * 同一连接上请求按顺序处理，客户端收到响应后才会改写共享内存。
+ */
+
+constexpr uint32_t kIpcMagic = 0x52504E49;  // "INPR"
+constexpr uint16_t kIpcVersion = 1;
+constexpr size_t kIpcMaxMessage = 128 << 10;
+constexpr size_t kIpcModelNameSize = 64;
+constexpr const char* kIpcDefaultSocket = "/tmp/rknn_inference.sock";
+
+enum class IpcOp : uint16_t
+{
+    INFO = 1,             // 查询模型属性
+    PREDICT = 2,          // 共享内存中的cv::Mat像素
+    PREDICT_ENCODED = 3,  // 共享内存中的编码图像（JPEG/PNG...）
+};
+
+enum class IpcStatus : uint16_t
+{
+    OK = 0,
+    BAD_REQUEST = 1,
+    UNKNOWN_MODEL = 2,
+    QUOTA_EXCEEDED = 3,
+    INFERENCE_FAILED = 4,
+    SHUTTING_DOWN = 5,
+};
+
+constexpr uint32_t IPC_FLAG_NEW_SHM = 1;  // 本消息附带新的共享内存fd
+
+struct IpcRequest
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t op;
+    uint32_t request_id;
+    uint32_t flags;
+    char model_name[kIpcModelNameSize];
+    uint64_t shm_size;     // 附带fd时为共享内存大小
+    uint64_t data_offset;  // 数据在共享内存中的偏移
+    uint64_t data_bytes;   // PREDICT_ENCODED的数据字节数
+    int32_t width;        // PREDICT的图像尺寸、类型与行字节数
+    int32_t height;
+    int32_t type;
+    uint32_t step;
+};
+
+struct IpcResponse
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t status;
+    uint32_t request_id;
+    uint32_t payload_bytes;
+    int32_t task_type;
+    float queue_ms;  // 在服务端排队的时间
+    // INFO
+    int32_t model_width;
+    int32_t model_height;
+    int32_t model_channels;
+    int32_t max_input_width;  // IModel::getMaxInputSize
+    int32_t max_input_height;
+    uint32_t reserved;
+    uint64_t weight_bytes;
+    uint64_t internal_bytes;
+    uint64_t io_bytes;
+    uint64_t host_bytes;
+    uint64_t sram_bytes;
+};
+
+const char* ipcStatusString(IpcStatus status);
+
+/**
+ * @brief 发送一条消息：header与payload合并为一个数据报，fd不为-1时以SCM_RIGHTS附带
+ */
+bool ipcSend(int sock, const void* header, size_t header_size, const void* payload, size_t payload_size,
+             int fd = -1);
+
+/**
+ * @brief 接收一条消息
+ * @param fd 输出随消息传递的fd，没有时为-1；调用方负责关闭
+ * @return 消息字节数，连接关闭返回0，出错返回-1
+ */
+ssize_t ipcRecv(int sock, void* buffer, size_t capacity, int* fd);
+
+}  // namespace rknn_cpp
@@ -0,0 +1,149 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include "rknn_cpp/ipc/inference_protocol.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+struct InferenceServerConfig
+{
+    std::string socket_path = kIpcDefaultSocket;
+    int max_batch = 4;                 // 每个上下文一次取出的最大请求数
+    int batch_timeout_us = 0;          // 队列不足max_batch时最多等待多久凑批，0表示有请求即处理
+    int max_inflight = 0;              // 每个客户端（进程）同时在处理的请求上限，0表示不限
+    double max_rps = 0.0;              // 每个客户端每秒请求数上限（令牌桶，突发为1秒的量且至少1个），0表示不限
+    size_t max_shm_bytes = 256 << 20;  // 客户端共享内存上限
+};
+
+struct InferenceServerStats
+{
+    struct ModelStats
+    {
+        std::string name;
+        size_t contexts = 0;
+        size_t requests = 0;
+        size_t failed = 0;
+        size_t batches = 0;
+        double queue_ms = 0.0;  // 累计排队时间
+        double avgBatch() const { return batches > 0 ? static_cast<double>(requests) / batches : 0.0; }
+        double avgQueueMs() const { return requests > 0 ? queue_ms / requests : 0.0; }
+    };
+    std::vector<ModelStats> models;
+    size_t connections = 0;     // 当前连接数
+    size_t rejected_quota = 0;  // 因配额被拒绝的请求
+    size_t bad_requests = 0;
+};
+
+/**
+ * @brief 本地推理服务：进程内持有模型，通过UNIX域套接字为其他进程提供predict
+ * 每个连接一个线程接收请求，图像位于客户端以fd传入的共享内存中，服务端直接在映射上构造cv::Mat推理，
+ * 不复制像素。请求进入所属模型的队列，模型的每个上下文一个工作线程，每次最多取出max_batch个请求连续执行
+ * （凑批时等待batch_timeout_us）。配额按对端进程（SO_PEERCRED的pid）统计。协议见inference_protocol.h，
+ * 客户端见RemoteModel。
+ */
+class InferenceServer
+{
+   public:
+    explicit InferenceServer(const InferenceServerConfig& config = InferenceServerConfig());
+    ~InferenceServer();
+
+    InferenceServer(const InferenceServer&) = delete;
+    InferenceServer& operator=(const InferenceServer&) = delete;
+
+    /**
+     * @brief 注册模型，须在start之前调用
+     * @param contexts 同一模型的一个或多个已初始化上下文，每个上下文由一个工作线程独占
+     */
+    bool addModel(const std::string& name, std::vector<std::unique_ptr<IModel>> contexts);
+
+    // 创建套接字（已存在的同名文件会被删除）并启动线程
+    bool start();
+    // 停止接收，断开所有连接，等待线程退出；已入队的请求返回SHUTTING_DOWN
+    void stop();
+    bool isRunning() const { return running_; }
+
+    InferenceServerStats getStats() const;
+    void printSummary() const;
+
+   private:
+    struct Job
+    {
+        IpcOp op = IpcOp::PREDICT;
+        cv::Mat image;                  // PREDICT：共享内存上的视图
+        const uint8_t* data = nullptr;  // PREDICT_ENCODED
+        size_t size = 0;
+        std::chrono::steady_clock::time_point enqueue_time;
+
+        InferenceResult result;
+        IpcStatus status = IpcStatus::OK;
+        float queue_ms = 0.0f;
+        bool done = false;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    struct ModelEntry
+    {
+        std::string name;
+        std::vector<std::unique_ptr<IModel>> contexts;
+        std::vector<std::thread> workers;
+        std::deque<Job*> queue;
+        std::mutex mutex;
+        std::condition_variable cv;
+        InferenceServerStats::ModelStats stats;
+    };
+
+    struct ClientQuota
+    {
+        int inflight = 0;
+        double tokens = 0.0;
+        std::chrono::steady_clock::time_point last_refill;
+        int connections = 0;
+    };
+
+    struct Connection
+    {
+        int fd = -1;
+        pid_t pid = 0;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+    };
+
+    void acceptLoop();
+    void connectionLoop(Connection* connection);
+    void workerLoop(ModelEntry* entry, IModel* model);
+
+    void handleRequest(Connection* connection, const IpcRequest& request, const uint8_t* shm, size_t shm_size,
+                       std::vector<char>& payload, IpcResponse& response);
+    bool acquireQuota(pid_t pid);
+    void releaseQuota(pid_t pid);
+    void reapConnections();
+
+    InferenceServerConfig config_;
+    std::map<std::string, std::unique_ptr<ModelEntry>> models_;
+
+    int listen_fd_;
+    std::atomic<bool> running_;
+    std::thread accept_thread_;
+
+    mutable std::mutex connections_mutex_;
+    std::vector<std::unique_ptr<Connection>> connections_;
+
+    mutable std::mutex quota_mutex_;
+    std::map<pid_t, ClientQuota> quotas_;
+    size_t rejected_quota_;
+    size_t bad_requests_;
+};
+
+}  // namespace rknn_cpp
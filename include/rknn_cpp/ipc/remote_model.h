@@ -0,0 +1,98 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include "rknn_cpp/ipc/inference_protocol.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief InferenceServer的客户端，实现IModel接口，可替换进程内模型
+ * 图像写入本对象持有的共享内存（memfd），只通过套接字传递请求描述；getInputBuffer返回的Mat已位于共享内存中，
+ * 在其上解码/绘制后调用predict（含ROI）不再复制像素。
+ * 配置项：socket_path、model_name（服务端注册的名称）、timeout_ms（等待响应的超时，0表示不超时）。
+ * predictTensors与逐层性能分析不支持远程调用。
+ */
+class RemoteModel : public IModel
+{
+   public:
+    explicit RemoteModel(const std::string& socket_path = kIpcDefaultSocket, const std::string& model_name = "");
+    ~RemoteModel() override;
+
+    RemoteModel(const RemoteModel&) = delete;
+    RemoteModel& operator=(const RemoteModel&) = delete;
+
+    bool initialize(const ModelConfig& config) override;
+    std::future<bool> initializeAsync(const ModelConfig& config) override;
+    InferenceResult predict(const cv::Mat& image) override;
+    InferenceResult predict(const cv::Mat& image, const cv::Rect& roi) override;
+    InferenceResult predictTensors(const std::vector<InputTensor>& inputs) override;
+    InferenceResult predictEncoded(const uint8_t* data, size_t size) override;
+    InferenceResult predictFile(const std::string& path) override;
+    void release() override;
+
+    std::vector<LayerProfile> getLayerProfile() const override;
+    void resetLayerProfile() override;
+    // 服务端模型的内存占用（初始化时查询）
+    ModelMemoryUsage getMemoryUsage() const override;
+
+    ModelTask getTaskType() const override;
+    std::string getModelName() const override;
+    bool isInitialized() const override;
+
+    int getModelWidth() const override;
+    int getModelHeight() const override;
+    int getModelChannels() const override;
+    cv::Size getMaxInputSize() const override;
+
+    /**
+     * @brief 返回位于共享内存中的图像缓冲区
+     * 缓冲区扩容会使之前返回的Mat失效；同一时刻只应使用一个
+     */
+    cv::Mat getInputBuffer(int width, int height, int type);
+
+   private:
+    bool connectServer();
+    void disconnect();
+    bool ensureBuffer(size_t bytes);
+    bool inBuffer(const void* data, size_t bytes) const;
+
+    // 发送请求并接收响应，payload指向内部接收缓冲区
+    bool call(IpcRequest& request, IpcResponse& response, const char*& payload, size_t& payload_size);
+    InferenceResult callPredict(IpcRequest& request, std::chrono::steady_clock::time_point start);
+    InferenceResult predictLocked(const cv::Mat& image, std::chrono::steady_clock::time_point start);
+    InferenceResult predictEncodedLocked(const uint8_t* data, size_t size,
+                                         std::chrono::steady_clock::time_point start);
+    InferenceResult createFailedResult(std::chrono::steady_clock::time_point start) const;
+
+    std::string socket_path_;
+    std::string model_name_;   // 服务端注册的名称
+    std::string remote_name_;  // 服务端模型的getModelName()
+    int timeout_ms_;
+
+    int sock_;
+    int shm_fd_;
+    uint8_t* shm_;
+    size_t shm_size_;
+    bool shm_sent_;  // 当前连接上服务端是否已持有shm_fd_
+    uint32_t next_request_id_;
+    std::vector<char> recv_buffer_;
+
+    // initialize/release在mutex_下写入；预测期间一直持有mutex_，查询接口读原子变量，不等待正在进行的请求
+    std::atomic<bool> initialized_;
+    std::atomic<ModelTask> task_type_;
+    std::atomic<int> model_width_;
+    std::atomic<int> model_height_;
+    std::atomic<int> model_channels_;
+    cv::Size max_input_size_;  // 受mutex_保护
+    ModelMemoryUsage memory_usage_;
+
+    mutable std::mutex mutex_;
+};
+
+}  // namespace rknn_cpp
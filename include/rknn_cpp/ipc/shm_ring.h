@@ -0,0 +1,156 @@
+#pragma once
+#include "rknn_cpp/types.h"
+#include "rknn_cpp/utils/result_serializer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace rknn_cpp
+{
+
+/**
+ * 共享内存环形缓冲区布局（同一台设备上的进程间使用，无跨字节序需求）：
+ *   ShmRingHeader | slot_count个槽位，每个槽位为 ShmSlotHeader + 结果记录 + 帧像素
+ * 结果以二进制记录存放（见serializeBinary），帧为逐行紧密排列的像素。
+ * 每个槽位用seqlock保护：写入时seq为奇数，写完为偶数；读者复制数据前后seq一致且为偶数即读取成功，
+ * 读者不写共享内存，也不会阻塞发布者。
+ */
+struct ShmRingHeader
+{
+    std::atomic<uint32_t> magic;  // 初始化完成后最后写入
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;  // 单个槽位字节数（含ShmSlotHeader）
+    uint32_t max_result_bytes;
+    uint32_t max_frame_bytes;
+    std::atomic<uint64_t> latest_seq;  // 最新发布的帧序号（从1开始），0表示尚未发布
+};
+
+struct ShmSlotHeader
+{
+    std::atomic<uint64_t> lock;  // seqlock计数
+    uint64_t seq;                // 槽位中帧的序号
+    int64_t timestamp_us;
+    uint32_t result_bytes;
+    uint32_t frame_bytes;
+    int32_t frame_width;
+    int32_t frame_height;
+    int32_t frame_type;  // cv::Mat类型，如CV_8UC3
+    uint32_t reserved;
+};
+
+struct ShmRingConfig
+{
+    std::string name;                    // 共享内存名称，如"/rknn_results"
+    uint32_t slot_count = 8;             // 槽位数，读者落后超过slot_count帧时丢帧
+    size_t max_result_bytes = 16 << 10;  // 单帧结果记录上限
+    size_t max_frame_bytes = 0;          // 单帧像素上限，0表示不发布图像
+};
+
+/**
+ * @brief 发布者：每帧的InferenceResult（及可选图像）写入共享内存环形缓冲区
+ * 每个名称只允许一个发布者进程；同一进程内多线程publish由内部互斥量串行化。
+ */
+class ShmResultPublisher
+{
+   public:
+    ShmResultPublisher() = default;
+    ~ShmResultPublisher();
+
+    ShmResultPublisher(const ShmResultPublisher&) = delete;
+    ShmResultPublisher& operator=(const ShmResultPublisher&) = delete;
+
+    // 创建（或重建）共享内存
+    bool create(const ShmRingConfig& config);
+    // 解除映射并删除共享内存名称，已打开的读者仍可读取已映射的数据
+    void close();
+
+    /**
+     * @brief 发布一帧
+     * @param frame 原图或预处理后的图像，可为空；超过max_frame_bytes时只发布结果
+     * @return 该帧序号，失败返回0（结果记录超过max_result_bytes）
+     */
+    uint64_t publish(const InferenceResult& result, const cv::Mat* frame = nullptr, int64_t timestamp_us = 0);
+
+   private:
+    std::string name_;
+    ShmRingHeader* header_ = nullptr;
+    char* base_ = nullptr;
+    size_t mapped_size_ = 0;
+    uint64_t next_seq_ = 1;
+    bool frame_warned_ = false;
+    std::mutex mutex_;
+};
+
+// 读者读取到的一帧
+struct ShmFrame
+{
+    uint64_t seq = 0;
+    int64_t timestamp_us = 0;
+    BinaryResultRecord result;
+    cv::Mat image;  // 未发布图像时为空；多次读取间复用内存
+};
+
+/**
+ * @brief 订阅者：只读映射共享内存，按序号读取帧
+ */
+class ShmResultSubscriber
+{
+   public:
+    enum class ReadStatus
+    {
+        OK,
+        NOT_READY,    // 该序号尚未发布
+        OVERWRITTEN,  // 已被新帧覆盖（读者落后太多）
+        TORN,         // 槽位长时间处于写入中（发布者可能在写入时崩溃），本次不返回数据
+    };
+
+    ShmResultSubscriber() = default;
+    ~ShmResultSubscriber();
+
+    ShmResultSubscriber(const ShmResultSubscriber&) = delete;
+    ShmResultSubscriber& operator=(const ShmResultSubscriber&) = delete;
+
+    // 发布者尚未创建或尚未初始化完成时返回false，可稍后重试
+    bool open(const std::string& name);
+    void close();
+
+    /**
+     * @brief 检测发布者是否已重建共享内存（重启后create会删除并重建同名段），是则重新映射新段
+     * 旧映射不会收到新帧，比较名称当前对应的inode即可发现。next/readLatest没有新帧时会自动检查（限频）。
+     * @return 已重新打开时返回true，之后next从新段的最新帧开始
+     */
+    bool reopenIfRestarted();
+
+    uint64_t getLatestSeq() const;
+    ReadStatus read(uint64_t seq, ShmFrame& frame);
+    // 读取最新一帧
+    bool readLatest(ShmFrame& frame);
+    /**
+     * @brief 按序读取上次读取之后的下一帧
+     * @param dropped 输出因落后被覆盖而跳过的帧数，可为空
+     * @return 没有新帧时返回false
+     */
+    bool next(ShmFrame& frame, uint64_t* dropped = nullptr);
+
+   private:
+    // 没有新帧时限频检查发布者是否重建，已重新打开时返回true
+    bool checkRestart();
+
+    std::string name_;
+    dev_t device_ = 0;
+    ino_t inode_ = 0;
+    int64_t last_restart_check_us_ = 0;
+    const ShmRingHeader* header_ = nullptr;
+    const char* base_ = nullptr;
+    size_t mapped_size_ = 0;
+    uint64_t last_seq_ = 0;
+    std::vector<char> result_buffer_;
+};
+
+}  // namespace rknn_cpp
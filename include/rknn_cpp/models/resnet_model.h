@@ -37,5 +37,6 @@ class ResNetModel : public BaseModelImpl
     // 成员变量
     std::vector<std::string> class_names_;
     bool class_names_loaded_;
+    cv::Mat resized_img_;  // 预处理缩放缓冲区，跨帧复用
 };
 }  // namespace rknn_cpp
\ No newline at end of file
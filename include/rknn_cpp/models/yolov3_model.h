@@ -29,6 +29,7 @@ class Yolov3Model : public BaseModelImpl
     bool setupModel(const ModelConfig& config) override;
     bool preprocessImage(const cv::Mat& src_img, cv::Mat& dst_img) override;  // 新增cv::Mat重载
     InferenceResult postprocessOutputs(rknn_output* outputs, int output_count) override;
+    void resetPreprocessState() override;
 
    private:
     // 成员变量
@@ -49,20 +50,13 @@ class Yolov3Model : public BaseModelImpl
     std::string getClassName(int class_id) const;
     // 工具函数
     float sigmoid(float x) const;
-    float deqnt_affine_to_f32(int8_t qnt, int32_t zp, float scale) const;
-    int processYoloLayer(void* input, bool is_quantized, const YoloLayer& layer, std::vector<float>& boxes,
-                         std::vector<float>& objProbs, std::vector<int>& classId, float threshold, int32_t zp = 0,
-                         float scale = 0) const;
+    int processYoloLayer(const rknn_output& output, int output_index, const YoloLayer& layer,
+                         std::vector<float>& boxes, std::vector<float>& objProbs, std::vector<int>& classId,
+                         float threshold) const;
 
     std::vector<int> applyNMS(const std::vector<float>& boxes, const std::vector<float>& scores,
                               const std::vector<int>& classIds, float nms_threshold = 0.45f) const;
 
-    int nmsForClass(const std::vector<float>& boxes, const std::vector<int>& classIds, std::vector<int>& order,
-                    int filterId, float threshold) const;
-
-    float calculateIoU(float xmin0, float ymin0, float xmax0, float ymax0, float xmin1, float ymin1, float xmax1,
-                       float ymax1) const;
-
     // Letterbox坐标转换
     void convertLetterboxToOriginal(DetectionResults& detections, int orig_width, int orig_height) const;
 };
@@ -0,0 +1,106 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include "rknn_cpp/utils/result_serializer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace rknn_cpp
+{
+
+struct BatchRunnerConfig
+{
+    int decode_threads = 2;         // 解码线程数
+    int prefetch = 8;               // 每个模型上下文之外最多预取的已解码图像数
+    std::string output_path;        // 结果输出，按输入顺序
+    ResultFormat format = ResultFormat::JSONL;
+    std::string checkpoint_path;    // 为空时使用output_path + ".ckpt"
+    int checkpoint_interval = 100;  // 每写出多少条结果更新一次断点
+    bool resume = true;             // 存在匹配的断点时从断点继续
+    int progress_interval = 500;    // 每处理多少张打印一次进度，0表示不打印
+};
+
+struct BatchStats
+{
+    size_t total = 0;      // 输入总数
+    size_t skipped = 0;    // 断点续跑时跳过的已完成条目
+    size_t processed = 0;  // 本次处理的条目
+    size_t failed = 0;     // 解码或推理失败
+    double elapsed_s = 0.0;
+
+    double imagesPerSec() const { return elapsed_s > 0.0 ? processed / elapsed_s : 0.0; }
+};
+
+/**
+ * @brief 目录/清单批量推理
+ * 解码线程池按输入顺序预取并解码（JPEG解码时按模型输入尺寸缩小），多个模型上下文并行推理，
+ * 结果按输入顺序写为JSON Lines或二进制记录（见result_serializer.h）。定期写断点（已完成条目数与输出文件长度），中断后重新运行时
+ * 截掉断点之后写出的部分并从断点继续。
+ */
+class BatchRunner
+{
+   public:
+    // models为同一模型的多个已初始化上下文，每个上下文由一个推理线程独占
+    BatchRunner(const std::vector<IModel*>& models, const BatchRunnerConfig& config);
+
+    // path为目录时递归列出图像文件并排序；否则作为清单文件，每行一个路径（相对路径相对于清单所在目录）
+    static std::vector<std::string> listInputs(const std::string& path);
+
+    bool run(const std::vector<std::string>& inputs);
+    // 可从其他线程调用：处理完已开始的条目后停止，断点保留
+    void stop();
+    BatchStats getStats() const;
+
+   private:
+    struct Decoded
+    {
+        cv::Mat image;
+        int factor = 1;
+        cv::Size source_size;  // 原图尺寸，用于把检测框还原并裁剪到原图范围
+        double decode_ms = 0.0;
+    };
+
+    struct Completed
+    {
+        InferenceResult result;
+        bool decode_failed = false;
+    };
+
+    struct Checkpoint
+    {
+        size_t next_index = 0;
+        uint64_t output_bytes = 0;
+        uint64_t inputs_hash = 0;
+    };
+
+    void decodeLoop();
+    void inferLoop(IModel* model);
+    bool openOutput(uint64_t inputs_hash);
+    bool writeCheckpoint(size_t next_index);
+
+    std::vector<IModel*> models_;
+    BatchRunnerConfig config_;
+    std::vector<std::string> inputs_;
+    uint64_t inputs_hash_ = 0;
+    ResultStreamWriter output_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::map<size_t, Decoded> decoded_;
+    std::map<size_t, Completed> results_;
+    size_t next_decode_ = 0;
+    size_t next_write_ = 0;
+    size_t end_ = 0;
+    size_t window_ = 0;
+    int decoding_ = 0;        // 正在解码的条目数
+    int active_workers_ = 0;  // 未退出的解码/推理线程数
+    bool stop_ = false;
+    BatchStats stats_;
+};
+
+}  // namespace rknn_cpp
@@ -0,0 +1,50 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace rknn_cpp
+{
+
+// 检测→分类级联配置
+struct CascadeConfig
+{
+    float min_confidence = 0.0f;     // 低于该置信度的检测框不做分类
+    int min_crop_size = 8;           // 宽或高小于该值的检测框不做分类
+    float crop_padding = 0.0f;       // 裁剪区域按框尺寸的比例向外扩展
+    size_t top_k = 1;                // 每个检测框保留的分类结果数，0表示全部
+    std::vector<int> class_filter;   // 只对这些检测类别做分类，为空表示全部
+};
+
+/**
+ * @brief 检测→分类级联
+ * 先对整帧检测，再直接在原图上按检测框做ROI分类（不拷贝裁剪区域），
+ * 分类结果写入每个DetectionResult::classifications。
+ *
+ * 多个分类模型上下文时，检测框轮流分配到各上下文并行分类；
+ * 每个上下文在单独线程上依次处理分到的检测框。
+ */
+class DetectorClassifierCascade
+{
+   public:
+    DetectorClassifierCascade(IModel* detector, const std::vector<IModel*>& classifiers,
+                              const CascadeConfig& config = {});
+
+    // 返回带分类结果的检测结果，inference_time为检测与全部分类推理时间之和
+    InferenceResult predict(const cv::Mat& image);
+
+    // 仅对给定检测结果做分类（检测已在别处完成时使用）
+    bool classify(const cv::Mat& image, DetectionResults& detections, float* inference_time = nullptr);
+
+    const CascadeConfig& getConfig() const { return config_; }
+
+   private:
+    cv::Rect cropRegion(const DetectionResult& detection, int image_width, int image_height) const;
+    bool shouldClassify(const DetectionResult& detection) const;
+
+    IModel* detector_;
+    std::vector<IModel*> classifiers_;
+    CascadeConfig config_;
+};
+
+}  // namespace rknn_cpp
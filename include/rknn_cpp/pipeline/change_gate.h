@@ -0,0 +1,84 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <opencv2/opencv.hpp>
+
+namespace rknn_cpp
+{
+
+// 帧变化门控配置
+struct ChangeGateConfig
+{
+    std::string stream_name = "default";  // 指标标签，区分不同视频流
+    int signature_width = 64;             // 签名尺寸
+    int signature_height = 36;
+    float threshold = 3.0f;               // 平均逐像素差（0~255）不超过该值视为场景无变化
+    int max_stale_ms = 1000;              // 复用结果的最长时间，超过后强制推理，0表示不限制
+    int max_stale_frames = 0;             // 连续复用的最大帧数，0表示不限制
+};
+
+/**
+ * @brief 帧变化检测
+ * 与最近一次推理所用帧的签名比较（而不是上一帧），缓慢变化累积到阈值后同样会触发推理。
+ */
+class FrameChangeGate
+{
+   public:
+    explicit FrameChangeGate(const ChangeGateConfig& config = {});
+
+    // 计算当前帧签名，返回true表示需要推理（场景变化、结果过期或尚无参考帧）
+    bool check(const cv::Mat& image);
+    // 推理成功后调用：以当前帧签名作为新的参考
+    void accept();
+    void reset();
+
+    float getLastDistance() const { return last_distance_; }
+    bool wasForced() const { return last_forced_; }  // 上次check是否因过期强制推理
+    const ChangeGateConfig& getConfig() const { return config_; }
+
+   private:
+    ChangeGateConfig config_;
+    cv::Mat reference_;
+    cv::Mat current_;
+    std::chrono::steady_clock::time_point reference_time_;
+    int stale_frames_ = 0;
+    float last_distance_ = 0.0f;
+    bool last_forced_ = false;
+};
+
+/**
+ * @brief 带变化门控的推理
+ * 场景无变化时直接返回上次推理结果，跳过整个predict流程；每个流的命中率写入指标注册表：
+ * rknn_gate_frames_total / rknn_gate_skipped_total / rknn_gate_forced_total{stream="..."}
+ * 一个GatedPredictor对应一路视频流，不可跨线程并发调用。
+ */
+class GatedPredictor
+{
+   public:
+    GatedPredictor(IModel* model, const ChangeGateConfig& config = {});
+
+    InferenceResult predict(const cv::Mat& image);
+
+    // 跳过推理的帧占比
+    double getHitRate() const;
+    uint64_t getFrameCount() const { return frames_->load(std::memory_order_relaxed); }
+    uint64_t getSkippedCount() const { return skipped_->load(std::memory_order_relaxed); }
+    void reset();
+
+   private:
+    IModel* model_;
+    FrameChangeGate gate_;
+    InferenceResult cached_result_;
+    bool has_cached_result_ = false;
+
+    // 计数器由进程级注册表持有，同名流共享
+    std::atomic<uint64_t>* frames_;
+    std::atomic<uint64_t>* skipped_;
+    std::atomic<uint64_t>* forced_;
+    uint64_t local_frames_ = 0;
+    uint64_t local_skipped_ = 0;
+};
+
+}  // namespace rknn_cpp
@@ -0,0 +1,46 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace rknn_cpp
+{
+
+// 分块推理配置
+struct TilingConfig
+{
+    int tile_width = 0;                // tile宽度，0表示使用模型输入宽度
+    int tile_height = 0;               // tile高度，0表示使用模型输入高度
+    float overlap = 0.2f;              // 相邻tile的重叠比例 [0, 0.9]
+    bool global_pass = true;           // 额外对整图做一次低分辨率推理，补充大目标
+    float merge_threshold = 0.5f;      // 跨tile合并的重叠阈值
+    bool merge_use_ios = true;         // 合并时使用交集/较小框面积，处理被tile边界截断的框
+};
+
+/**
+ * @brief 高分辨率图像分块检测
+ * 将大图切成相互重叠、与模型输入等大的tile，分发到一个或多个检测模型上下文并行推理，
+ * 把每个tile的检测框映射回整图坐标后，跨tile做NMS合并重复框。
+ *
+ * 传入的多个检测模型必须已初始化且互相独立（各自拥有RKNN上下文），
+ * 每个上下文在单独线程上依次处理分到的tile。
+ */
+class TiledDetector
+{
+   public:
+    TiledDetector(const std::vector<IModel*>& detectors, const TilingConfig& config = {});
+
+    // 对整帧进行分块检测，返回整图坐标下的检测结果
+    InferenceResult predict(const cv::Mat& image);
+
+    // 计算给定图像尺寸下的tile划分
+    std::vector<cv::Rect> computeTiles(int image_width, int image_height) const;
+
+    const TilingConfig& getConfig() const { return config_; }
+
+   private:
+    std::vector<IModel*> detectors_;
+    TilingConfig config_;
+};
+
+}  // namespace rknn_cpp
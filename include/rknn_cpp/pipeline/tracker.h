@@ -0,0 +1,150 @@
+#pragma once
+#include "rknn_cpp/imodel.h"
+#include "rknn_cpp/utils/box_utils.h"
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace rknn_cpp
+{
+
+// 多目标跟踪配置（ByteTrack风格两阶段关联）
+struct TrackerConfig
+{
+    float high_threshold = 0.5f;  // 高分检测：参与第一阶段关联，未匹配时新建轨迹
+    float low_threshold = 0.1f;   // 低分检测：只用于第二阶段延续已有轨迹
+    float match_iou = 0.3f;       // 关联所需的最小IoU
+    int max_age = 30;             // 连续未匹配的检测帧数超过该值时删除轨迹
+    int min_hits = 2;             // 匹配次数达到该值后轨迹才输出
+    bool class_aware = true;      // 只关联同类别的检测与轨迹
+};
+
+/**
+ * @brief 恒速模型的框状态滤波
+ * 状态为中心点与宽高各自的(位置, 速度)，四个维度的过程与观测噪声相互独立，
+ * 等价于对角噪声下的8维卡尔曼滤波，每个维度只需2x2协方差。
+ */
+class KalmanBoxFilter
+{
+   public:
+    KalmanBoxFilter() = default;
+    explicit KalmanBoxFilter(const cv::Rect2f& box);
+
+    // 按经过的帧数预测，返回预测框
+    cv::Rect2f predict(float frames = 1.0f);
+    // 用观测框校正
+    void update(const cv::Rect2f& box);
+    cv::Rect2f getBox() const;
+
+   private:
+    struct Axis
+    {
+        float pos = 0.0f, vel = 0.0f;
+        float p00 = 0.0f, p01 = 0.0f, p11 = 0.0f;  // 协方差
+    };
+    void predictAxis(Axis& axis, float dt, float noise) const;
+    void updateAxis(Axis& axis, float measurement, float noise) const;
+
+    Axis axes_[4];  // cx, cy, w, h
+};
+
+// 一条轨迹
+struct Track
+{
+    int track_id = 0;
+    KalmanBoxFilter filter;
+    DetectionResult detection;  // 最近一次匹配的检测（坐标为当前估计）
+    int hits = 0;               // 累计匹配次数
+    int misses = 0;             // 连续未匹配的检测帧数
+    bool confirmed = false;
+};
+
+/**
+ * @brief 多目标跟踪器（SORT/ByteTrack风格）
+ * 检测帧调用update，跳过检测的帧调用predict，二者都返回带稳定track_id的框；
+ * 关联使用与NMS相同的批量IoU（overlapOneToMany）并按IoU贪心匹配。
+ */
+class MultiObjectTracker
+{
+   public:
+    explicit MultiObjectTracker(const TrackerConfig& config = {});
+
+    // 用检测结果更新轨迹，frames_since_last为距上次update/predict经过的帧数
+    DetectionResults update(const DetectionResults& detections, float frames_since_last = 1.0f);
+    // 无检测的帧：仅按运动模型外推
+    DetectionResults predict(float frames_since_last = 1.0f);
+    void reset();
+
+    size_t getTrackCount() const { return tracks_.size(); }
+    // 最近一次update中新建与删除的轨迹数，供检测调度使用
+    int getLastCreated() const { return last_created_; }
+    int getLastRemoved() const { return last_removed_; }
+
+   private:
+    void associate(const std::vector<size_t>& track_indices, const DetectionResults& detections,
+                   const std::vector<size_t>& det_indices, std::vector<int>& track_to_det,
+                   std::vector<char>& det_used) const;
+    DetectionResults collectOutputs() const;
+
+    TrackerConfig config_;
+    std::vector<Track> tracks_;
+    int next_id_ = 1;
+    int last_created_ = 0;
+    int last_removed_ = 0;
+};
+
+// 检测调度配置
+struct DetectionScheduleConfig
+{
+    int min_stride = 1;          // 检测间隔（帧）的下限
+    int max_stride = 4;          // 检测间隔的上限
+    int stable_to_increase = 3;  // 连续多少次检测轨迹无增减后增大间隔
+};
+
+/**
+ * @brief 按跟踪稳定性调整检测间隔
+ * 轨迹数稳定时逐步增大间隔，出现新目标或丢失目标时立即回到最小间隔。
+ */
+class DetectionScheduler
+{
+   public:
+    explicit DetectionScheduler(const DetectionScheduleConfig& config = {});
+
+    // 当前帧是否需要检测（每帧调用一次）
+    bool shouldDetect();
+    // 检测帧结束后反馈轨迹变化
+    void report(int created, int removed);
+    void reset();
+
+    int getStride() const { return stride_; }
+
+   private:
+    DetectionScheduleConfig config_;
+    int stride_;
+    int frames_since_detect_;
+    int stable_count_ = 0;
+};
+
+/**
+ * @brief 检测+跟踪：每隔若干帧检测一次，中间帧由跟踪器外推，每帧都输出带track_id的框
+ * 一个TrackingDetector对应一路视频流，不可跨线程并发调用。
+ */
+class TrackingDetector
+{
+   public:
+    TrackingDetector(IModel* detector, const TrackerConfig& tracker_config = {},
+                     const DetectionScheduleConfig& schedule_config = {});
+
+    // 检测失败时is_success为false，result_data仍为外推的轨迹（跟踪器照常推进一帧）
+    InferenceResult predict(const cv::Mat& image);
+    void reset();
+
+    int getStride() const { return scheduler_.getStride(); }
+    const MultiObjectTracker& getTracker() const { return tracker_; }
+
+   private:
+    IModel* detector_;
+    MultiObjectTracker tracker_;
+    DetectionScheduler scheduler_;
+};
+
+}  // namespace rknn_cpp
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <any>
+#include <cstdint>
 
 namespace rknn_cpp
 {
@@ -37,17 +38,78 @@ struct ResizeConfig : public PreprocessConfig
     bool keep_aspect_ratio = false;
 };
 
-// ===== 推理结果类型定义 =====
+// ===== 张量级输入定义 =====
 
-// 检测结果
-struct DetectionResult
+// 输入张量数据类型
+enum class TensorType
 {
-    uint16_t x, y, width, height;  // 边界框坐标和尺寸
-    float confidence;              // 置信度
-    uint16_t class_id;             // 类别ID
-    std::string class_name;        // 类别名称
+    UINT8,
+    INT8,
+    FLOAT16,
+    FLOAT32
+};
+
+// 输入张量数据排布
+enum class TensorLayout
+{
+    NHWC,
+    NCHW,
+    UNDEFINED  // 非4维张量
 };
 
+// 张量级输入：调用方直接提供模型某个输入的数据
+struct InputTensor
+{
+    std::string name;                          // 输入名称，非空时按名称匹配模型输入
+    int index = -1;                            // 输入序号，name为空时使用
+    const void* data = nullptr;                // 数据指针，推理期间需保持有效
+    size_t size = 0;                           // 数据字节数
+    TensorType type = TensorType::UINT8;       // 数据类型
+    TensorLayout layout = TensorLayout::NHWC;  // 数据排布
+    bool pass_through = false;                 // 为true时数据不经运行时转换直接送入NPU
+};
+
+// ===== 逐层性能分析 =====
+
+// 单次推理中一个算子的耗时（解析自RKNN_QUERY_PERF_DETAIL）
+struct LayerPerf
+{
+    int id = 0;
+    std::string name;     // 算子全名
+    std::string op_type;  // 算子类型，如ConvRelu
+    std::string target;   // 执行单元：NPU / CPU / GPU ...
+    uint32_t time_us = 0;
+};
+
+// 多次推理聚合后的算子统计
+struct LayerProfile
+{
+    int id = 0;
+    std::string name;
+    std::string op_type;
+    std::string target;
+    size_t runs = 0;
+    double total_us = 0.0;
+    double min_us = 0.0;
+    double max_us = 0.0;
+    double avgUs() const { return runs > 0 ? total_us / runs : 0.0; }
+};
+
+// ===== 内存统计 =====
+
+// 单个模型占用的内存（字节）
+struct ModelMemoryUsage
+{
+    size_t weight_bytes = 0;    // 权重
+    size_t internal_bytes = 0;  // 中间层（激活）
+    size_t io_bytes = 0;        // 运行时分配的输入输出张量
+    size_t host_bytes = 0;      // 本库在主机侧分配的缓冲区
+    size_t sram_bytes = 0;      // 位于片上SRAM的中间层内存，不计入total()
+    size_t total() const { return weight_bytes + internal_bytes + io_bytes + host_bytes; }
+};
+
+// ===== 推理结果类型定义 =====
+
 // 分类结果
 struct ClassificationResult
 {
@@ -56,6 +118,17 @@ struct ClassificationResult
     float confidence;        // 置信度
 };
 
+// 检测结果
+struct DetectionResult
+{
+    uint16_t x, y, width, height;  // 边界框坐标和尺寸
+    float confidence;              // 置信度
+    uint16_t class_id;             // 类别ID
+    std::string class_name;        // 类别名称
+    std::vector<ClassificationResult> classifications;  // 级联分类结果（见DetectorClassifierCascade）
+    int32_t track_id = -1;                              // 跟踪ID（见TrackingDetector），-1表示未跟踪
+};
+
 // 推理结果的集合类型
 using DetectionResults = std::vector<DetectionResult>;
 using ClassificationResults = std::vector<ClassificationResult>;
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief 按SIMD对齐的字节缓冲区
+ * 只增不减：resize到更小的尺寸时保留已分配的内存，避免帧间反复分配
+ */
+class AlignedBuffer
+{
+   public:
+    static constexpr size_t kDefaultAlignment = 64;  // 覆盖NEON/AVX以及cache line
+
+    AlignedBuffer() = default;
+    explicit AlignedBuffer(size_t size) { resize(size); }
+    ~AlignedBuffer() { std::free(data_); }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+    AlignedBuffer(AlignedBuffer&& other) noexcept : data_(other.data_), size_(other.size_), capacity_(other.capacity_)
+    {
+        other.data_ = nullptr;
+        other.size_ = other.capacity_ = 0;
+    }
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::free(data_);
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.size_ = other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    // 调整有效尺寸，超过容量时重新分配（不保留旧数据）
+    bool resize(size_t size)
+    {
+        if (size > capacity_)
+        {
+            size_t capacity = (size + kDefaultAlignment - 1) / kDefaultAlignment * kDefaultAlignment;
+            void* data = std::aligned_alloc(kDefaultAlignment, capacity);
+            if (data == nullptr)
+            {
+                return false;
+            }
+            std::free(data_);
+            data_ = static_cast<uint8_t*>(data);
+            capacity_ = capacity;
+        }
+        size_ = size;
+        return true;
+    }
+
+    void fill(uint8_t value)
+    {
+        if (data_ != nullptr) std::memset(data_, value, size_);
+    }
+
+    void release()
+    {
+        std::free(data_);
+        data_ = nullptr;
+        size_ = capacity_ = 0;
+    }
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+   private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+}  // namespace rknn_cpp
@@ -0,0 +1,55 @@
+#pragma once
+#include "rknn_cpp/types.h"
+#include <vector>
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief 检测框工具函数
+ * 提供IoU计算与按类别的NMS，供检测模型后处理和多次推理结果合并共用
+ */
+
+// 计算两个框 (xmin, ymin, xmax, ymax) 的IoU
+float calculateIoU(float xmin0, float ymin0, float xmax0, float ymax0, float xmin1, float ymin1, float xmax1,
+                   float ymax1);
+
+// 计算交集占较小框面积的比例，用于合并被切割的框
+float calculateIoS(float xmin0, float ymin0, float xmax0, float ymax0, float xmin1, float ymin1, float xmax1,
+                   float ymax1);
+
+// 结构数组形式的框集合 (xmin, ymin, xmax, ymax)，便于批量计算重叠度
+struct BoxArray
+{
+    std::vector<float> xmin, ymin, xmax, ymax;
+
+    size_t size() const { return xmin.size(); }
+    void reserve(size_t n);
+    void clear();
+    void push_back(float x0, float y0, float x1, float y1);
+};
+
+/**
+ * @brief 计算一个框与boxes[begin, end)中每个框的重叠度
+ * 与calculateIoU / calculateIoS结果一致，NEON / SSE一次处理4个框
+ * @param out 输出数组，至少end - begin个元素
+ */
+void overlapOneToMany(float xmin, float ymin, float xmax, float ymax, const BoxArray& boxes, size_t begin,
+                      size_t end, float* out, bool use_ios = false);
+
+/**
+ * @brief 按类别进行NMS
+ * @param boxes 扁平化的框数组，每4个值为 (x, y, w, h)
+ * @param scores 每个框的置信度
+ * @param classIds 每个框的类别ID
+ * @param nms_threshold 重叠阈值
+ * @param use_ios 为true时使用IoS替代IoU
+ * @return 保留框的索引，按置信度降序
+ */
+std::vector<int> nmsBoxes(const std::vector<float>& boxes, const std::vector<float>& scores,
+                          const std::vector<int>& classIds, float nms_threshold, bool use_ios = false);
+
+// 对检测结果直接做NMS，结果按置信度降序
+void nmsDetections(DetectionResults& detections, float nms_threshold, bool use_ios = false);
+
+}  // namespace rknn_cpp
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace rknn_cpp
+{
+
+// 两个uint8数组的绝对差之和（SAD），NEON / SSE2 / 标量实现
+uint64_t sumAbsDiffU8(const uint8_t* a, const uint8_t* b, size_t count);
+
+/**
+ * @brief 计算帧签名：缩小到width x height的灰度图
+ * 使用INTER_AREA缩小以平均掉传感器噪声，签名大小与输入分辨率无关
+ */
+void computeFrameSignature(const cv::Mat& image, int width, int height, cv::Mat& signature);
+
+// 两个签名的平均逐像素差（0~255），尺寸不一致时返回255
+float signatureDistance(const cv::Mat& a, const cv::Mat& b);
+
+namespace reference
+{
+uint64_t sumAbsDiffU8(const uint8_t* a, const uint8_t* b, size_t count);
+}  // namespace reference
+
+}  // namespace rknn_cpp
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "rknn_cpp/types.h"
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief 从JPEG头部（SOFn段）读取图像尺寸，不解码像素
+ * @return 不是JPEG或数据不完整时返回false
+ */
+bool readJpegSize(const uint8_t* data, size_t size, int& width, int& height);
+
+/**
+ * @brief 从JPEG的APP1 Exif段读取方向标签（0x0112）
+ * @return 1-8，没有Exif或方向标签时返回1；5-8表示解码后宽高互换
+ */
+int readJpegOrientation(const uint8_t* data, size_t size);
+
+/**
+ * @brief 选择libjpeg DCT缩放系数（1/2/4/8）：缩小后两个方向仍不小于目标尺寸的最大系数
+ */
+int selectReducedFactor(int src_width, int src_height, int dst_width, int dst_height);
+
+/**
+ * @brief 解码编码后的图像（BGR）
+ * JPEG按min_width x min_height选择IMREAD_REDUCED_COLOR_*在解码时缩小，其他格式按原尺寸解码。
+ * EXIF方向为5-8（旋转90度）时解码结果宽高互换，按互换后的原图尺寸选择缩放系数。
+ * @param factor 输出实际使用的缩放系数，可为空
+ * @param source_size 输出按EXIF方向旋转后的原图尺寸（即不缩小时的解码尺寸），可为空
+ */
+cv::Mat decodeImage(const uint8_t* data, size_t size, int min_width, int min_height, int* factor = nullptr,
+                    cv::Size* source_size = nullptr);
+
+/**
+ * @brief 将缩小解码图像上的检测框还原到原图坐标
+ * @param source_size 原图尺寸（decodeImage输出），检测框裁剪到该范围内。
+ *                    宽高不是factor的整数倍时，decoded_size * factor会超出原图
+ */
+void restoreDecodeScale(InferenceResult& result, int factor, const cv::Size& source_size);
+
+// 读取整个文件
+bool readFileBytes(const std::string& path, std::vector<uint8_t>& data);
+
+}  // namespace rknn_cpp
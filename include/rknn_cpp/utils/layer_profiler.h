@@ -0,0 +1,37 @@
+#pragma once
+#include "rknn_cpp/types.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief 解析RKNN_QUERY_PERF_DETAIL返回的逐层耗时表
+ * 按表头定位ID/OpType/Target/Time列，兼容不同运行时版本的列顺序；算子全名取每行最后一列
+ * @return 未找到表头或没有任何数据行时返回false
+ */
+bool parsePerfDetail(const char* text, std::vector<LayerPerf>& layers);
+
+// 跨多次推理聚合逐层耗时
+class LayerProfiler
+{
+   public:
+    void accumulate(const std::vector<LayerPerf>& layers);
+    void reset();
+    size_t runs() const { return runs_; }
+
+    // 按总耗时降序返回
+    std::vector<LayerProfile> profile() const;
+
+    // 格式化为文本表格，top_n为0时输出全部；同时汇总各执行单元的耗时占比
+    static std::string formatTable(const std::vector<LayerProfile>& profile, size_t top_n = 0);
+
+   private:
+    std::vector<LayerProfile> layers_;
+    std::unordered_map<std::string, size_t> index_;  // 算子全名 -> layers_下标
+    size_t runs_ = 0;
+};
+
+}  // namespace rknn_cpp
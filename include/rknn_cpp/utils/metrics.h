@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief 固定分桶直方图
+ * observe只做原子加，可在推理热路径上无锁调用；输出为Prometheus的累计桶格式
+ */
+class Histogram
+{
+   public:
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    const std::vector<double>& bounds() const { return bounds_; }
+    uint64_t bucketCount(size_t index) const { return buckets_[index].load(std::memory_order_relaxed); }
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    double sum() const;
+
+   private:
+    std::vector<double> bounds_;                       // 各桶上界，升序，末尾隐含+Inf
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;  // bounds_.size() + 1 个桶，非累计
+    std::atomic<uint64_t> count_{0};
+    std::atomic<int64_t> sum_milli_{0};  // 以千分之一为单位的定点累加，避免原子浮点运算
+};
+
+// 单个模型（按getModelName()区分）的运行指标
+struct ModelMetrics
+{
+    explicit ModelMetrics(const std::string& name);
+
+    std::string model_name;
+    std::atomic<uint64_t> frames_total{0};      // 成功处理的帧数
+    std::atomic<uint64_t> failures_total{0};    // 失败的推理次数
+    std::atomic<uint64_t> detections_total{0};  // 累计检测/分类结果数
+    Histogram detections_per_frame;
+    Histogram preprocess_ms;
+    Histogram inference_ms;
+    Histogram postprocess_ms;
+    Histogram total_ms;
+};
+
+/**
+ * @brief 进程级指标注册表
+ * 注册（首次获取某模型的指标）需加锁，返回的指针在进程生命周期内有效，
+ * 之后的更新都是无锁原子操作。
+ */
+class MetricsRegistry
+{
+   public:
+    static MetricsRegistry& instance();
+
+    // 获取模型指标，不存在时创建
+    ModelMetrics* getModelMetrics(const std::string& model_name);
+
+    // 获取带标签的通用计数器（如rknn_gate_skipped_total{stream="cam0"}），不存在时创建
+    // labels为Prometheus标签体，如 stream="cam0"；同名计数器的help以首次注册为准
+    std::atomic<uint64_t>* getCounter(const std::string& name, const std::string& help, const std::string& labels);
+
+    // 按Prometheus文本格式转义标签值中的反斜杠、双引号和换行
+    static std::string escapeLabelValue(const std::string& value);
+
+    // 以Prometheus文本格式导出全部指标
+    std::string renderPrometheus() const;
+
+    // 写入文件（先写临时文件再rename，避免采集端读到半个文件）
+    bool writeToFile(const std::string& path) const;
+
+    // 在127.0.0.1:port上提供 /metrics HTTP接口
+    bool startHttpServer(int port);
+    void stopHttpServer();
+
+   private:
+    MetricsRegistry() = default;
+    ~MetricsRegistry();
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    void serveHttp(int listen_fd);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<ModelMetrics>> models_;
+
+    struct CounterFamily
+    {
+        std::string help;
+        std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> series;  // 标签 -> 计数
+    };
+    std::map<std::string, CounterFamily> counters_;
+
+    std::thread http_thread_;
+    std::atomic<bool> http_running_{false};
+    int http_fd_ = -1;
+};
+
+}  // namespace rknn_cpp
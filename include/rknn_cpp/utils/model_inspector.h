@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+// 模型输入/输出张量属性（RKNN_QUERY_INPUT_ATTR / OUTPUT_ATTR）
+struct TensorInfo
+{
+    int index = 0;
+    std::string name;
+    std::vector<uint32_t> dims;
+    std::string format;    // NCHW / NHWC / ...
+    std::string type;      // INT8 / FP16 / ...
+    std::string qnt_type;  // AFFINE / DFP / NONE
+    int32_t zero_point = 0;
+    float scale = 1.0f;
+    uint32_t n_elems = 0;
+    uint32_t size = 0;  // 字节数
+};
+
+// 不分配NPU内存即可获得的模型信息
+struct ModelInfo
+{
+    bool valid = false;
+    bool from_cache = false;  // 来自旁路缓存文件
+    std::string path;
+    uint64_t file_size = 0;
+    int64_t file_mtime = 0;
+
+    std::string api_version;
+    std::string driver_version;
+    std::string custom_string;
+    std::vector<TensorInfo> inputs;
+    std::vector<TensorInfo> outputs;
+
+    // 加载后的内存需求
+    uint64_t weight_bytes = 0;
+    uint64_t internal_bytes = 0;
+
+    uint64_t ioBytes() const
+    {
+        uint64_t bytes = 0;
+        for (const auto& tensor : inputs)
+        {
+            bytes += tensor.size;
+        }
+        for (const auto& tensor : outputs)
+        {
+            bytes += tensor.size;
+        }
+        return bytes;
+    }
+    // 加载后NPU侧内存的估计值（权重 + 中间层 + 输入输出）
+    uint64_t estimatedBytes() const { return weight_bytes + internal_bytes + ioBytes(); }
+};
+
+/**
+ * @brief 以RKNN_FLAG_COLLECT_MODEL_INFO_ONLY初始化并读取模型信息，不分配权重和中间层内存
+ * 结果缓存在模型旁的<path>.info文件中，按文件大小和修改时间判断是否失效；缓存目录不可写时忽略
+ * @param path 模型文件路径
+ * @param use_cache 为false时总是重新查询（仍会更新缓存）
+ */
+ModelInfo inspectModel(const std::string& path, bool use_cache = true);
+
+// 以文本形式打印模型信息
+void printModelInfo(const ModelInfo& info);
+
+}  // namespace rknn_cpp
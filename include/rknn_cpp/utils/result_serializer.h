@@ -0,0 +1,110 @@
+#pragma once
+#include "rknn_cpp/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+enum class ResultFormat
+{
+    JSONL,   // 每条结果一行JSON
+    BINARY,  // 固定schema的二进制记录，见serializeBinary
+};
+
+// 随结果一起输出的记录信息
+struct ResultRecordInfo
+{
+    uint64_t index = 0;         // 帧号/输入序号
+    int64_t timestamp_us = 0;   // 时间戳，0表示不输出（JSON）
+    std::string_view source;    // 来源（文件路径、流名称），可为空
+    std::string_view error;     // 失败原因，可为空（仅JSON输出）
+};
+
+/**
+ * @brief 序列化为一行JSON（含结尾换行）到调用方缓冲区，数值用std::to_chars格式化，不分配内存
+ * 检测带有级联分类结果时输出嵌套的classifications数组；nan/inf写为null
+ * @return 写入的字节数；缓冲区不足时返回0
+ */
+size_t serializeJson(const InferenceResult& result, const ResultRecordInfo& info, char* buffer, size_t capacity);
+
+/**
+ * @brief 序列化为二进制记录（小端）
+ * 记录头48字节：
+ *   magic "RKR1"(4) version u16 kind u8(0无结果 1检测 2分类) flags u8(bit0成功) record_size u32 count u32
+ *   index u64 timestamp_us i64 inference_ms f32 total_ms f32 source_len u32 reserved u32
+ * 之后为source（补齐到4字节），再接count个条目：
+ *   检测 20字节：x y width height class_id(u16) cls_count(u16) confidence(f32) track_id(i32)
+ *   分类 8字节：class_id(u16) reserved(u16) confidence(f32)
+ * 检测记录在全部检测条目之后按检测顺序接各检测的cls_count个级联分类条目（格式同分类）。
+ * 类别名称不写入，由使用方按class_id映射。
+ * @return 写入的字节数；缓冲区不足时返回0
+ */
+size_t serializeBinary(const InferenceResult& result, const ResultRecordInfo& info, char* buffer, size_t capacity);
+
+// 二进制记录所需的字节数
+size_t binaryRecordSize(const InferenceResult& result, const ResultRecordInfo& info);
+
+// 解码后的二进制记录
+struct BinaryResultRecord
+{
+    uint64_t index = 0;
+    int64_t timestamp_us = 0;
+    bool success = false;
+    float inference_ms = 0.0f;
+    float total_ms = 0.0f;
+    std::string source;
+    DetectionResults detections;
+    ClassificationResults classifications;
+};
+
+/**
+ * @brief 解码一条二进制记录
+ * @param consumed 输出该记录占用的字节数，可用于顺序读取记录流
+ * @return 数据不完整或格式错误时返回false
+ */
+bool decodeBinaryRecord(const char* data, size_t size, BinaryResultRecord& record, size_t& consumed);
+
+/**
+ * @brief 批量写出到文件或fd
+ * 结果先序列化到内部缓冲区，缓冲区满或调用flush时一次write写出；稳态下不分配内存
+ * （单条记录超过缓冲区时缓冲区扩容一次）。
+ */
+class ResultStreamWriter
+{
+   public:
+    // 写入已打开的fd，不负责关闭
+    explicit ResultStreamWriter(int fd, ResultFormat format = ResultFormat::JSONL, size_t buffer_size = 64 << 10);
+    ResultStreamWriter(ResultFormat format = ResultFormat::JSONL, size_t buffer_size = 64 << 10);
+    ~ResultStreamWriter();
+
+    ResultStreamWriter(const ResultStreamWriter&) = delete;
+    ResultStreamWriter& operator=(const ResultStreamWriter&) = delete;
+
+    // 打开文件，append为false时清空
+    bool open(const std::string& path, bool append);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    bool write(const InferenceResult& result, const ResultRecordInfo& info);
+    bool flush();
+
+    // 已写入文件的字节数（含打开时已有的内容），flush后即为文件长度
+    uint64_t getFileOffset() const { return file_offset_; }
+    ResultFormat getFormat() const { return format_; }
+
+   private:
+    size_t serialize(const InferenceResult& result, const ResultRecordInfo& info, char* buffer, size_t capacity) const;
+
+    int fd_;
+    bool own_fd_;
+    ResultFormat format_;
+    std::vector<char> buffer_;
+    size_t used_;
+    uint64_t file_offset_;
+};
+
+}  // namespace rknn_cpp
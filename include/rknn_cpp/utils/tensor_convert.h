@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace rknn_cpp
+{
+
+/**
+ * @brief 张量数据转换内核
+ * 每个内核提供标量参考实现，并在支持的平台上使用SIMD实现。
+ */
+
+// 每通道仿射量化参数: q = saturate(round(x * mul[c] + add[c]))
+// 由 (x - mean) / std / scale + zp 展开而来，见 makeInputQuantParams
+struct InputQuantParams
+{
+    static constexpr int kMaxChannels = 4;
+    int channels = 0;
+    float mul[kMaxChannels] = {};
+    float add[kMaxChannels] = {};
+    int8_t lut[kMaxChannels][256] = {};  // uint8输入的完整查找表，标量路径使用
+};
+
+// 根据模型输入的均值/方差与量化参数生成每通道量化系数
+InputQuantParams makeInputQuantParams(int channels, const float* mean, const float* stdv, int32_t zp, float scale);
+
+/**
+ * @brief uint8 HWC图像量化为int8 NHWC原生布局
+ * @param src 连续的HWC像素数据
+ * @param dst_w_stride 目标每行像素数（>= width，原生布局可能按宽度对齐）
+ */
+void quantizeU8ToI8NHWC(const uint8_t* src, int height, int width, const InputQuantParams& params, int dst_w_stride,
+                        int8_t* dst);
+
+/**
+ * @brief uint8 HWC图像量化为int8 NC1HWC2原生布局
+ * 通道c写入 [c / c2][h][w][c % c2]，多余的通道槽位不写入，调用方需预先填充零点
+ */
+void quantizeU8ToI8NC1HWC2(const uint8_t* src, int height, int width, const InputQuantParams& params, int c2,
+                           int dst_w_stride, int8_t* dst);
+
+// ===== 输出转换内核：int8/uint8/fp16 -> fp32 =====
+
+// 仿射反量化: dst[i] = (src[i] - zp) * scale
+void dequantizeI8ToF32(const int8_t* src, size_t count, int32_t zp, float scale, float* dst);
+void dequantizeU8ToF32(const uint8_t* src, size_t count, int32_t zp, float scale, float* dst);
+
+// IEEE半精度转单精度，src为fp16的位模式
+void convertF16ToF32(const uint16_t* src, size_t count, float* dst);
+
+// 跨步读取并转换: dst[i] = convert(src[i * stride])，用于只读取NCHW张量中某个位置的各通道
+void gatherI8ToF32(const int8_t* src, size_t stride, size_t count, int32_t zp, float scale, float* dst);
+void gatherU8ToF32(const uint8_t* src, size_t stride, size_t count, int32_t zp, float scale, float* dst);
+void gatherF16ToF32(const uint16_t* src, size_t stride, size_t count, float* dst);
+void gatherF32(const float* src, size_t stride, size_t count, float* dst);
+
+// 标量参考实现，便于对照验证。反量化按 (x - zp) * scale 计算，SIMD实现展开为 x * scale + bias，
+// 两者在浮点舍入误差内一致（可能相差最后一位），fp16转换结果完全一致
+namespace reference
+{
+void dequantizeI8ToF32(const int8_t* src, size_t count, int32_t zp, float scale, float* dst);
+void dequantizeU8ToF32(const uint8_t* src, size_t count, int32_t zp, float scale, float* dst);
+void convertF16ToF32(const uint16_t* src, size_t count, float* dst);
+}  // namespace reference
+
+}  // namespace rknn_cpp
@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rknn_cpp
+{
+
+// 一个已完成的时间片，name须为字符串字面量（只保存指针）
+struct TraceEvent
+{
+    const char* name;
+    uint64_t start_us;
+    uint64_t duration_us;
+};
+
+/**
+ * @brief 进程级span记录器，导出Chrome trace-event JSON（chrome://tracing / Perfetto）
+ * 每个线程写自己的缓冲区；未启用时每个span只多一次relaxed原子读。
+ */
+class Tracer
+{
+   public:
+    static Tracer& instance();
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    static uint64_t nowMicros()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // 开始记录（清空已有数据）/ 停止记录
+    void start();
+    void stop();
+
+    // 记录接下来的frame_count帧，结束后自动写出到path
+    void captureFrames(int frame_count, const std::string& path);
+    // 每帧结束时调用（最外层的TraceFrameScope），用于帧窗口计数
+    void frameEnd();
+
+    // 将已记录的数据写为Chrome trace JSON
+    bool dumpChromeTrace(const std::string& path);
+
+    void record(const char* name, uint64_t start_us, uint64_t end_us);
+
+   private:
+    struct ThreadBuffer
+    {
+        uint32_t tid;
+        std::mutex mutex;  // 只在导出/清空时与其他线程竞争
+        std::vector<TraceEvent> events;
+    };
+
+    Tracer() = default;
+    ThreadBuffer* threadBuffer();
+    void clear();
+
+    static std::atomic<bool> enabled_;
+    static constexpr size_t kMaxEventsPerThread = 1 << 20;
+
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    std::atomic<int> frames_remaining_{0};
+    std::string capture_path_;
+};
+
+// RAII span：构造时记录开始时间，析构时写入当前线程的缓冲区
+class TraceScope
+{
+   public:
+    explicit TraceScope(const char* name) : name_(Tracer::isEnabled() ? name : nullptr)
+    {
+        if (name_ != nullptr) start_us_ = Tracer::nowMicros();
+    }
+    ~TraceScope()
+    {
+        if (name_ != nullptr) Tracer::instance().record(name_, start_us_, Tracer::nowMicros());
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+   private:
+    const char* name_;
+    uint64_t start_us_ = 0;
+};
+
+// 帧级span：析构时先写入span，再推进帧窗口计数（保证最后一帧完整写出）。
+// 帧可以嵌套（predictEncoded -> predict、分块检测 -> 每个tile的predict），只有线程上最外层的帧计数，
+// 这样trace_frames=N记录的是N个顶层请求
+class TraceFrameScope
+{
+   public:
+    explicit TraceFrameScope(const char* name)
+        : name_(Tracer::isEnabled() ? name : nullptr), outermost_(depth()++ == 0)
+    {
+        if (name_ != nullptr) start_us_ = Tracer::nowMicros();
+    }
+    ~TraceFrameScope()
+    {
+        depth()--;
+        if (name_ != nullptr)
+        {
+            Tracer::instance().record(name_, start_us_, Tracer::nowMicros());
+            if (outermost_) Tracer::instance().frameEnd();
+        }
+    }
+    TraceFrameScope(const TraceFrameScope&) = delete;
+    TraceFrameScope& operator=(const TraceFrameScope&) = delete;
+
+    // 当前线程的帧嵌套深度
+    static int& depth()
+    {
+        static thread_local int frame_depth = 0;
+        return frame_depth;
+    }
+
+   private:
+    const char* name_;
+    bool outermost_;
+    uint64_t start_us_ = 0;
+};
+
+// 在工作线程中延续调用方的帧：作用域内的TraceFrameScope都视为嵌套帧，不单独计数
+class TraceFrameContinuation
+{
+   public:
+    TraceFrameContinuation() { TraceFrameScope::depth()++; }
+    ~TraceFrameContinuation() { TraceFrameScope::depth()--; }
+    TraceFrameContinuation(const TraceFrameContinuation&) = delete;
+    TraceFrameContinuation& operator=(const TraceFrameContinuation&) = delete;
+};
+
+#define RKNN_TRACE_CONCAT_INNER(a, b) a##b
+#define RKNN_TRACE_CONCAT(a, b) RKNN_TRACE_CONCAT_INNER(a, b)
+#define RKNN_TRACE_SCOPE(name) ::rknn_cpp::TraceScope RKNN_TRACE_CONCAT(rknn_trace_scope_, __LINE__)(name)
+#define RKNN_TRACE_FRAME(name) ::rknn_cpp::TraceFrameScope RKNN_TRACE_CONCAT(rknn_trace_frame_, __LINE__)(name)
+#define RKNN_TRACE_FRAME_CONTINUE() \
+    ::rknn_cpp::TraceFrameContinuation RKNN_TRACE_CONCAT(rknn_trace_continue_, __LINE__)
+
+}  // namespace rknn_cpp
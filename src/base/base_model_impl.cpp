@@ -1,9 +1,16 @@
 #include "rknn_cpp/base/base_model_impl.h"
+#include "rknn_cpp/base/memory_manager.h"
+#include "rknn_cpp/base/scratch_group.h"
+#include "rknn_cpp/utils/image_decode.h"
 #include <iostream>
 #include <fstream>
 #include <cstring>
 #include <iomanip>
 #include <chrono>
+#include <algorithm>
+#include <sstream>
+#include <cmath>
+#include <filesystem>
 
 namespace rknn_cpp
 {
@@ -15,8 +22,25 @@ BaseModelImpl::BaseModelImpl()
       model_channels_(0),
       original_width_(0),
       original_height_(0),
+      roi_offset_(0, 0),
       initialized_(false),
       is_quant_(false),
+      current_shape_index_(-1),
+      dynamic_shape_enabled_(false),
+      native_input_enabled_(false),
+      profiling_enabled_(false),
+      internal_mem_(nullptr),
+      sram_bytes_(0),
+      evicted_(false),
+      last_used_(0),
+      use_scheduler_(false),
+      npu_priority_(NpuPriority::MEDIUM),
+      deadline_ms_(0),
+      warming_up_(false),
+      warmup_runs_(0),
+      cold_latency_ms_(0.0),
+      warm_latency_ms_(0.0),
+      metrics_(nullptr),
       preprocess_buffer_{}
 {
     memset(&io_num_, 0, sizeof(io_num_));
@@ -28,6 +52,13 @@ BaseModelImpl::~BaseModelImpl()
 }
 
 bool BaseModelImpl::initialize(const ModelConfig& config)
+{
+    // 初始化（含预热）全程持有run_mutex_：其他线程的内存预算淘汰（tryEvict）不会释放正在初始化的上下文
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    return initializeLocked(config);
+}
+
+bool BaseModelImpl::initializeLocked(const ModelConfig& config)
 {
     if (initialized_)
     {
@@ -35,7 +66,6 @@ bool BaseModelImpl::initialize(const ModelConfig& config)
         return true;
     }
 
-    // 1. 加载RKNN模型
     std::cout << "\n" << std::string(60, '=') << std::endl;
     std::cout << "                  MODEL INITIALIZATION" << std::endl;
     std::cout << std::string(60, '=') << std::endl;
@@ -45,14 +75,62 @@ bool BaseModelImpl::initialize(const ModelConfig& config)
         std::cerr << "Model path not specified in config" << std::endl;
         return false;
     }
-    std::string model_path = model_path_it->second;
+
+    // 保存配置，被内存预算淘汰后按原配置重新初始化
+    if (&config != &config_)
+    {
+        config_ = config;
+    }
+    evicted_ = false;
+
+    // 内存预算：加载前以模型文件大小预估（权重占主要部分），不足时淘汰最久未使用的空闲模型
+    MemoryManager& memory_manager = MemoryManager::instance();
+    int budget_mb = getConfigInt(config, "memory_budget_mb", 0);
+    if (budget_mb > 0)
+    {
+        memory_manager.setBudget(static_cast<size_t>(budget_mb) << 20);
+    }
+    std::error_code ec;
+    uintmax_t file_size = std::filesystem::file_size(model_path_it->second, ec);
+    if (!memory_manager.reserve(this, ec ? 0 : static_cast<size_t>(file_size)))
+    {
+        std::cerr << "Not enough memory budget to load model: " << model_path_it->second << std::endl;
+        return false;
+    }
+
+    if (!initializeContext(config))
+    {
+        releaseResources();
+        memory_manager.unregister(this);
+        return false;
+    }
+    return true;
+}
+
+std::future<bool> BaseModelImpl::initializeAsync(const ModelConfig& config)
+{
+    // 按值捕获配置，调用方的config可在返回后销毁
+    return std::async(std::launch::async, [this, config]() { return initialize(config); });
+}
+
+bool BaseModelImpl::initializeContext(const ModelConfig& config)
+{
+    // 1. 加载RKNN模型
+    std::string model_path = config.at("model_path");
     std::cout << "[LOAD] Loading model file: " << model_path << std::endl;
-    if (!loadRKNNModel(model_path))
+    uint32_t init_flags = getInitFlags(config);
+    if (!loadRKNNModel(model_path, init_flags))
     {
         std::cerr << "Failed to load RKNN model: " << model_path << std::endl;
         return false;
     }
 
+    // 1.1 中间层内存由本库分配（SRAM优先）
+    if (!setupInternalMemory(config, init_flags))
+    {
+        return false;
+    }
+
     // 2. 获取模型输入输出信息
     int ret = rknn_query(rknn_ctx_, RKNN_QUERY_IN_OUT_NUM, &io_num_, sizeof(io_num_));
     if (ret != RKNN_SUCC)
@@ -101,69 +179,182 @@ bool BaseModelImpl::initialize(const ModelConfig& config)
             is_quant_ = false;
         }
     }
-    // 5. 提取模型输入尺寸信息（假设第一个输入是图像）
-    if (io_num_.n_input > 0)
+    // 5. 查询动态shape范围，动态模型需要在推理前设置一次输入shape
+    if (!queryDynamicShapes(config))
     {
-        auto& input_attr = input_attrs_[0];
-        if (input_attr.n_dims == 4)
-        {  // NHWC or NCHW
-            if (input_attr.fmt == RKNN_TENSOR_NHWC)
-            {
-                model_height_ = input_attr.dims[1];
-                model_width_ = input_attr.dims[2];
-                model_channels_ = input_attr.dims[3];
-            }
-            else if (input_attr.fmt == RKNN_TENSOR_NCHW)
-            {
-                model_channels_ = input_attr.dims[1];
-                model_height_ = input_attr.dims[2];
-                model_width_ = input_attr.dims[3];
-            }
-        }
+        return false;
+    }
+
+    // 6. 提取模型输入尺寸信息（假设第一个输入是图像）
+    updateModelInputDims();
+    max_input_size_ = cv::Size(model_width_, model_height_);
+    for (const auto& shape : dynamic_shapes_)
+    {
+        max_input_size_.width = std::max(max_input_size_.width, shape.width);
+        max_input_size_.height = std::max(max_input_size_.height, shape.height);
+    }
+
+    // 6.1 原生布局输入（可选）
+    if (!setupNativeInput(config))
+    {
+        return false;
     }
 
-    // 6. 打印张量信息
+    // 7. 打印张量信息
     dumpTensorAttrs();
 
-    // 7. 初始化输出缓冲区
-    outputs_.resize(io_num_.n_output);
-    memset(outputs_.data(), 0, outputs_.size() * sizeof(rknn_output));
+    // 8. 初始化输出缓冲区
+    if (!allocateOutputBuffers())
+    {
+        std::cerr << "Failed to allocate output buffers" << std::endl;
+        return false;
+    }
 
-    // 8. 调用子类的模型设置
+    // 9. 调用子类的模型设置
     if (!setupModel(config))
     {
         std::cerr << "setupModel failed!" << std::endl;
         return false;
     }
 
+    // 10. 运行指标：按模型名称注册，之后的更新均为无锁原子操作
+    metrics_ = getConfigBool(config, "metrics", true) ? MetricsRegistry::instance().getModelMetrics(getModelName())
+                                                      : nullptr;
+
+    // 11. 逐层性能分析：每次推理后查询RKNN_QUERY_PERF_DETAIL并聚合
+    profiling_enabled_ = (init_flags & RKNN_FLAG_COLLECT_PERF_MASK) != 0;
+    layer_profiler_.reset();
+
+    // 12. 时间线追踪（可选）：记录接下来N帧的span并写出Chrome trace
+    int trace_frames = getConfigInt(config, "trace_frames", 0);
+    if (trace_frames > 0 && !Tracer::isEnabled())
+    {
+        auto path_it = config.find("trace_path");
+        Tracer::instance().captureFrames(trace_frames, path_it != config.end() ? path_it->second : "rknn_trace.json");
+    }
+
+    // 13. NPU调度：设置了priority或deadline_ms时默认启用，deadline_ms为0表示不限
+    auto priority_it = config.find("priority");
+    npu_priority_ = NpuScheduler::parsePriority(priority_it != config.end() ? priority_it->second : "medium");
+    deadline_ms_ = std::max(0, getConfigInt(config, "deadline_ms", 0));
+    use_scheduler_ = getConfigBool(config, "use_scheduler", priority_it != config.end() || deadline_ms_ > 0);
+
+    // 14. 内存统计：按实际占用更新预算记账，仍超出预算时初始化失败
+    queryMemoryUsage();
+    if (!MemoryManager::instance().commit(this, memory_usage_.total()))
+    {
+        std::cerr << "Model exceeds memory budget after loading (" << (memory_usage_.total() >> 20) << " MB)"
+                  << std::endl;
+        return false;
+    }
+
     initialized_ = true;
+
+    // 15. 预热：用灰色假帧走完整的预处理/推理/后处理，使运行时完成惰性分配
+    if (!warmup(getConfigInt(config, "warmup_runs", 0)))
+    {
+        initialized_ = false;
+        return false;
+    }
+
     std::cout << "\n[SUCCESS] Model initialization completed" << std::endl;
     std::cout << "[CONFIG] Input Dimensions: " << model_width_ << " x " << model_height_ << " x " << model_channels_
               << std::endl;
     std::cout << "[CONFIG] Quantization   : " << (is_quant_ ? "Enabled" : "Disabled") << std::endl;
+    if (native_input_enabled_)
+    {
+        std::cout << "[CONFIG] Native Input   : "
+                  << get_format_string(native_input_attrs_[0].fmt) << " (pass_through)" << std::endl;
+    }
+    if (!dynamic_shapes_.empty())
+    {
+        std::cout << "[CONFIG] Dynamic Shape  : " << dynamic_shapes_.size() << " shapes, "
+                  << (dynamic_shape_enabled_ ? "per-frame selection" : "fixed") << std::endl;
+    }
+    std::cout << "[CONFIG] Memory         : " << std::fixed << std::setprecision(1)
+              << memory_usage_.total() / 1048576.0 << " MB (weight " << memory_usage_.weight_bytes / 1048576.0
+              << ", internal " << memory_usage_.internal_bytes / 1048576.0 << ", io "
+              << memory_usage_.io_bytes / 1048576.0 << ", host " << memory_usage_.host_bytes / 1048576.0 << ")"
+              << std::defaultfloat << std::endl;
+    if (memory_usage_.sram_bytes > 0)
+    {
+        std::cout << "[CONFIG] SRAM           : " << (memory_usage_.sram_bytes >> 10) << " KB internal memory"
+                  << std::endl;
+    }
+    if (profiling_enabled_)
+    {
+        std::cout << "[CONFIG] Profiling      : per-layer (RKNN_QUERY_PERF_DETAIL)" << std::endl;
+    }
+    if (warmup_runs_ > 0)
+    {
+        std::cout << "[CONFIG] Warmup         : " << warmup_runs_ << " runs, cold " << std::fixed
+                  << std::setprecision(2) << cold_latency_ms_ << " ms, warm " << warm_latency_ms_ << " ms"
+                  << std::defaultfloat << std::endl;
+    }
+    if (use_scheduler_)
+    {
+        std::cout << "[CONFIG] Scheduler      : priority " << NpuScheduler::priorityName(npu_priority_) << ", deadline "
+                  << (deadline_ms_ > 0 ? std::to_string(deadline_ms_) + " ms" : std::string("none")) << std::endl;
+    }
     std::cout << std::string(60, '=') << std::endl;
     return true;
 }
 
 InferenceResult BaseModelImpl::predict(const cv::Mat& image)
 {
+    return predict(image, cv::Rect(0, 0, image.cols, image.rows));
+}
+
+InferenceResult BaseModelImpl::predict(const cv::Mat& frame, const cv::Rect& roi)
+{
+    RKNN_TRACE_FRAME("predict");
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
-    if (!initialized_)
+    last_used_.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+    request_start_ = start;
+    if (!ensureLoaded())
     {
-        std::cerr << "Model not initialized!" << std::endl;
-        return createEmptyResult();
+        return createFailedResult();
+    }
+    return runPipeline(frame, roi, start);
+}
+
+InferenceResult BaseModelImpl::runPipeline(const cv::Mat& frame, const cv::Rect& roi,
+                                           std::chrono::steady_clock::time_point start)
+{
+    // ROI裁剪到图像范围内，image为不拷贝像素的视图
+    cv::Rect region = roi & cv::Rect(0, 0, frame.cols, frame.rows);
+    if (region.empty())
+    {
+        std::cerr << "Invalid ROI: (" << roi.x << "," << roi.y << "," << roi.width << "," << roi.height << ")"
+                  << std::endl;
+        return createFailedResult();
     }
+    const cv::Mat image = frame(region);
+    roi_offset_ = region.tl();
 
-    // 保存原始图像尺寸，用于后处理坐标转换
+    // 保存原始图像尺寸（ROI尺寸），用于后处理坐标转换
     original_width_ = image.cols;
     original_height_ = image.rows;
 
+    // 动态shape模型：按图像长宽比选择padding最少的输入尺寸
+    if (dynamic_shape_enabled_ && !selectInputShape(image.cols, image.rows))
+    {
+        std::cerr << "Dynamic input shape selection failed!" << std::endl;
+        return createFailedResult();
+    }
+
     // 1. 直接使用cv::Mat预处理 - 独立Pipeline
     cv::Mat preprocessed_img;
-    if (!preprocessImage(image, preprocessed_img))
+    bool preprocessed;
+    {
+        RKNN_TRACE_SCOPE("preprocess");
+        preprocessed = preprocessImage(image, preprocessed_img);
+    }
+    if (!preprocessed)
     {
         std::cerr << "Image preprocessing failed!" << std::endl;
-        return createEmptyResult();
+        return createFailedResult();
     }
     std::chrono::steady_clock::time_point point1 = std::chrono::steady_clock::now();
     std::chrono::duration<double, std::milli> preprocess_duration = point1 - start;
@@ -173,14 +364,18 @@ InferenceResult BaseModelImpl::predict(const cv::Mat& image)
     if (!runRKNNInference(preprocessed_img))
     {
         std::cerr << "RKNN inference failed!" << std::endl;
-        return createEmptyResult();
+        return createFailedResult();
     }
     std::chrono::steady_clock::time_point point2 = std::chrono::steady_clock::now();
     std::chrono::duration<double, std::milli> inference_duration = point2 - point1;
     std::cout << "[INFO] RKNN inference time: " << inference_duration.count() << " ms" << std::endl;
 
     // 3. 后处理（共享逻辑）
-    InferenceResult result = postprocessOutputs(outputs_.data(), outputs_.size());
+    InferenceResult result;
+    {
+        RKNN_TRACE_SCOPE("postprocess");
+        result = postprocessOutputs(outputs_.data(), outputs_.size());
+    }
     std::chrono::steady_clock::time_point point3 = std::chrono::steady_clock::now();
     std::chrono::duration<double, std::milli> postprocess_duration = point3 - point2;
     std::cout << "[INFO] Postprocess time: " << postprocess_duration.count() << " ms" << std::endl;
@@ -188,177 +383,1264 @@ InferenceResult BaseModelImpl::predict(const cv::Mat& image)
               << (preprocess_duration + inference_duration + postprocess_duration).count() << " ms" << std::endl;
     result.total_time = (preprocess_duration + inference_duration + postprocess_duration).count();
     result.inference_time = (inference_duration).count();
+    recordMetrics(result, preprocess_duration.count(), inference_duration.count(), postprocess_duration.count());
 
-    // 4. 释放输出资源
-    rknn_outputs_release(rknn_ctx_, io_num_.n_output, outputs_.data());
-
+    // 输出缓冲区为预分配内存，无需rknn_outputs_release
     return result;
 }
 
-void BaseModelImpl::release()
+InferenceResult BaseModelImpl::predictTensors(const std::vector<InputTensor>& inputs)
 {
-    if (!initialized_)
+    RKNN_TRACE_FRAME("predictTensors");
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    last_used_.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+    request_start_ = start;
+    if (!ensureLoaded())
     {
-        return;  // 已经释放过了，直接返回
+        return createFailedResult();
     }
+    return runTensorPipeline(inputs, start);
+}
 
-    if (rknn_ctx_ != 0)
+InferenceResult BaseModelImpl::runTensorPipeline(const std::vector<InputTensor>& inputs,
+                                                 std::chrono::steady_clock::time_point start)
+{
+    // 张量输入没有原图，坐标以模型输入空间为准
+    original_width_ = model_width_;
+    original_height_ = model_height_;
+    roi_offset_ = cv::Point(0, 0);
+    resetPreprocessState();
+
+    if (!runRKNNInference(inputs))
     {
-        rknn_destroy(rknn_ctx_);
-        rknn_ctx_ = 0;
+        std::cerr << "RKNN inference failed!" << std::endl;
+        return createFailedResult();
     }
+    std::chrono::steady_clock::time_point point1 = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> inference_duration = point1 - start;
 
-    outputs_.clear();
-
-    input_attrs_.clear();
-    output_attrs_.clear();
+    InferenceResult result;
+    {
+        RKNN_TRACE_SCOPE("postprocess");
+        result = postprocessOutputs(outputs_.data(), outputs_.size());
+    }
+    std::chrono::duration<double, std::milli> total_duration = std::chrono::steady_clock::now() - start;
+    result.total_time = total_duration.count();
+    result.inference_time = inference_duration.count();
+    recordMetrics(result, 0.0, result.inference_time, result.total_time - result.inference_time);
+    std::cout << "[INFO] Tensor inference time: " << result.inference_time << " ms, total: " << result.total_time
+              << " ms" << std::endl;
 
-    initialized_ = false;
-    std::cout << "\n[RELEASE] Model resources freed" << std::endl;
+    return result;
 }
 
-bool BaseModelImpl::isInitialized() const
+InferenceResult BaseModelImpl::predictEncoded(const uint8_t* data, size_t size)
 {
-    return initialized_;
+    // 解码时缩小到不小于模型输入的尺寸，省去全分辨率解码和大部分resize。
+    // 动态shape模型按最大shape计算，不能用上一帧选择的shape，否则小图会使之后一直选择小shape
+    RKNN_TRACE_FRAME("predictEncoded");
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    cv::Size decode_size = getMaxInputSize();
+    int factor = 1;
+    cv::Size source_size;
+    cv::Mat image;
+    {
+        RKNN_TRACE_SCOPE("decode");
+        image = decodeImage(data, size, decode_size.width, decode_size.height, &factor, &source_size);
+    }
+    if (image.empty())
+    {
+        std::cerr << "Failed to decode image (" << size << " bytes)" << std::endl;
+        return createFailedResult();
+    }
+    std::chrono::duration<double, std::milli> decode_duration = std::chrono::steady_clock::now() - start;
+    std::cout << "[INFO] Image decode time: " << decode_duration.count() << " ms (1/" << factor << " scale, "
+              << image.cols << "x" << image.rows << ")" << std::endl;
+
+    InferenceResult result = predict(image);
+    result.total_time += decode_duration.count();
+
+    // 检测框还原到原图坐标
+    restoreDecodeScale(result, factor, source_size);
+    return result;
 }
 
-int BaseModelImpl::getModelWidth() const
+InferenceResult BaseModelImpl::predictFile(const std::string& path)
 {
-    return model_width_;
+    std::vector<uint8_t> data;
+    if (!readFileBytes(path, data))
+    {
+        return createFailedResult();
+    }
+    return predictEncoded(data.data(), data.size());
 }
 
-int BaseModelImpl::getModelHeight() const
+InferenceResult BaseModelImpl::createFailedResult() const
 {
-    return model_height_;
+    if (metrics_ != nullptr && !warming_up_)
+    {
+        metrics_->failures_total.fetch_add(1, std::memory_order_relaxed);
+    }
+    return createEmptyResult();
 }
 
-int BaseModelImpl::getModelChannels() const
+void BaseModelImpl::recordMetrics(const InferenceResult& result, double preprocess_ms, double inference_ms,
+                                  double postprocess_ms) const
 {
-    return model_channels_;
-}
+    if (metrics_ == nullptr || warming_up_)
+    {
+        return;
+    }
+    if (!result.is_success)
+    {
+        metrics_->failures_total.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
 
-// ===== Protected 工具方法实现 =====
+    // 只取结果数量，不拷贝结果数组
+    size_t count = 0;
+    if (const auto* detections = std::any_cast<DetectionResults>(&result.result_data))
+    {
+        count = detections->size();
+    }
+    else if (const auto* classifications = std::any_cast<ClassificationResults>(&result.result_data))
+    {
+        count = classifications->size();
+    }
 
-bool BaseModelImpl::loadRKNNModel(const std::string& model_path)
+    metrics_->frames_total.fetch_add(1, std::memory_order_relaxed);
+    metrics_->detections_total.fetch_add(count, std::memory_order_relaxed);
+    metrics_->detections_per_frame.observe(static_cast<double>(count));
+    metrics_->preprocess_ms.observe(preprocess_ms);
+    metrics_->inference_ms.observe(inference_ms);
+    metrics_->postprocess_ms.observe(postprocess_ms);
+    metrics_->total_ms.observe(result.total_time);
+}
+
+bool BaseModelImpl::warmup(int runs)
 {
-    // 1. 读取模型文件
-    std::ifstream file(model_path, std::ios::binary | std::ios::ate);
-    if (!file.is_open())
+    warmup_runs_ = 0;
+    cold_latency_ms_ = 0.0;
+    warm_latency_ms_ = 0.0;
+    if (runs <= 0)
     {
-        std::cerr << "Cannot open model file: " << model_path << std::endl;
-        return false;
+        return true;
     }
 
-    size_t model_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<char> model_data(model_size);
-    if (!file.read(model_data.data(), model_size))
+    // 单输入模型走图像路径（含预处理），多输入模型按input_attrs_送入全零张量
+    cv::Mat dummy_frame;
+    std::vector<std::vector<uint8_t>> dummy_data;
+    std::vector<InputTensor> dummy_inputs;
+    if (io_num_.n_input == 1)
     {
-        std::cerr << "Failed to read model file" << std::endl;
-        return false;
+        dummy_frame = cv::Mat(model_height_, model_width_, CV_8UC3, cv::Scalar(114, 114, 114));
+    }
+    else
+    {
+        dummy_data.resize(io_num_.n_input);
+        for (uint32_t i = 0; i < io_num_.n_input; i++)
+        {
+            const auto& attr = input_attrs_[i];
+            dummy_data[i].assign(attr.n_elems, 0);
+            InputTensor tensor;
+            tensor.index = static_cast<int>(i);
+            tensor.data = dummy_data[i].data();
+            tensor.size = dummy_data[i].size();
+            tensor.type = TensorType::UINT8;
+            tensor.layout = attr.n_dims != 4              ? TensorLayout::UNDEFINED
+                            : attr.fmt == RKNN_TENSOR_NCHW ? TensorLayout::NCHW
+                                                           : TensorLayout::NHWC;
+            dummy_inputs.push_back(tensor);
+        }
     }
-    file.close();
 
-    std::cout << "[INFO] Model file size: " << model_size << " bytes" << std::endl;
+    // 预热不计入运行指标、逐层统计，也不受截止时间限制
+    std::cout << "[WARMUP] Running " << runs << " warmup inferences..." << std::endl;
+    warming_up_ = true;
+    double warm_total_ms = 0.0;
+    bool ok = true;
+    for (int i = 0; i < runs && ok; i++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        request_start_ = start;
+        InferenceResult result = dummy_inputs.empty()
+                                     ? runPipeline(dummy_frame, cv::Rect(0, 0, model_width_, model_height_), start)
+                                     : runTensorPipeline(dummy_inputs, start);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        ok = result.is_success;
+        if (i == 0)
+        {
+            cold_latency_ms_ = elapsed.count();
+        }
+        else
+        {
+            warm_total_ms += elapsed.count();
+        }
+    }
+    warming_up_ = false;
+    layer_profiler_.reset();
 
-    // 2. 初始化RKNN
-    int ret = rknn_init(&rknn_ctx_, model_data.data(), model_size, 0, nullptr);
-    if (ret < 0)
+    if (!ok)
     {
-        std::cerr << "rknn_init failed! ret=" << ret << std::endl;
+        std::cerr << "Warmup inference failed" << std::endl;
         return false;
     }
-
+    warmup_runs_ = runs;
+    warm_latency_ms_ = runs > 1 ? warm_total_ms / (runs - 1) : cold_latency_ms_;
     return true;
 }
 
-bool BaseModelImpl::runRKNNInference(const cv::Mat& input_img)
+void BaseModelImpl::release()
 {
-    // 确保图像格式正确 - RGB格式
-    cv::Mat rgb_img = input_img;
-
-    // 验证图像尺寸
-    if (rgb_img.cols != model_width_ || rgb_img.rows != model_height_ || rgb_img.channels() != getModelChannels())
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    // 已被淘汰的模型只需清除待重载状态
+    MemoryManager::instance().unregister(this);
+    NpuScheduler::instance().unregister(this);
+    evicted_ = false;
+    if (!initialized_)
     {
-        std::cerr << "Image dimension mismatch: expected " << model_width_ << "x" << model_height_ << "x3, got "
-                  << rgb_img.cols << "x" << rgb_img.rows << "x" << rgb_img.channels() << std::endl;
-        return false;
+        return;  // 已经释放过了，直接返回
     }
 
-    // 1. 设置输入 - 直接使用cv::Mat数据
-    rknn_input inputs[1];
-    memset(inputs, 0, sizeof(inputs));
-    inputs[0].index = 0;
-    inputs[0].buf = rgb_img.data;
-    inputs[0].size = rgb_img.total() * rgb_img.elemSize();
-    inputs[0].pass_through = 0;
-    inputs[0].type = RKNN_TENSOR_UINT8;
-    inputs[0].fmt = RKNN_TENSOR_NHWC;
+    releaseResources();
+    std::cout << "\n[RELEASE] Model resources freed" << std::endl;
+}
 
-    int ret = rknn_inputs_set(rknn_ctx_, io_num_.n_input, inputs);
-    if (ret < 0)
+void BaseModelImpl::releaseResources()
+{
+    if (internal_mem_ != nullptr)
     {
-        std::cerr << "rknn_inputs_set failed! ret=" << ret << std::endl;
-        return false;
+        rknn_destroy_mem(rknn_ctx_, internal_mem_);
+        internal_mem_ = nullptr;
+    }
+    if (scratch_group_)
+    {
+        // 分组未能把arena迁走时ctx由分组保留并负责销毁
+        if (!scratch_group_->leave(rknn_ctx_))
+        {
+            rknn_ctx_ = 0;
+        }
+        scratch_group_.reset();
+    }
+    sram_bytes_ = 0;
+    if (rknn_ctx_ != 0)
+    {
+        rknn_destroy(rknn_ctx_);
+        rknn_ctx_ = 0;
     }
 
-    // 2. 执行推理
-    ret = rknn_run(rknn_ctx_, nullptr);
-    if (ret < 0)
+    outputs_.clear();
+    output_buffers_.clear();
+    inputs_.clear();
+    input_binding_.clear();
+    bound_inputs_.clear();
+    image_input_.clear();
+
+    input_attrs_.clear();
+    output_attrs_.clear();
+    input_ranges_.clear();
+    dynamic_shapes_.clear();
+    current_shape_index_ = -1;
+    dynamic_shape_enabled_ = false;
+    native_input_attrs_.clear();
+    native_input_buffer_.release();
+    native_input_enabled_ = false;
+    profiling_enabled_ = false;
+    layer_perf_.clear();
+
+    memory_usage_ = ModelMemoryUsage{};
+    initialized_ = false;
+}
+
+bool BaseModelImpl::tryEvict()
+{
+    // 推理中的模型不是空闲模型，不等待
+    std::unique_lock<std::mutex> lock(run_mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || !initialized_)
     {
-        std::cerr << "rknn_run failed! ret=" << ret << std::endl;
         return false;
     }
+    releaseResources();
+    evicted_ = true;
+    return true;
+}
 
-    // 3. 获取输出 - 设置want_float以获取浮点数据
-    for (uint32_t i = 0; i < io_num_.n_output; i++)
+bool BaseModelImpl::ensureLoaded()
+{
+    if (initialized_)
     {
-        outputs_[i].want_float = (!is_quant_);
+        return true;
     }
-
-    ret = rknn_outputs_get(rknn_ctx_, io_num_.n_output, outputs_.data(), nullptr);
-    if (ret < 0)
+    if (!evicted_)
     {
-        std::cerr << "rknn_outputs_get failed! ret=" << ret << std::endl;
+        std::cerr << "Model not initialized!" << std::endl;
+        return false;
+    }
+    std::cout << "[MEMORY] Reloading evicted model " << getModelName() << std::endl;
+    if (!initializeLocked(config_))
+    {
+        std::cerr << "Failed to reload evicted model" << std::endl;
+        evicted_ = true;
         return false;
     }
-
     return true;
 }
 
-void BaseModelImpl::dumpTensorAttrs() const
+void BaseModelImpl::queryMemoryUsage()
 {
-    std::cout << "\n" << std::string(80, '=') << std::endl;
-    std::cout << "                           MODEL TENSOR INFORMATION" << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
+    memory_usage_ = ModelMemoryUsage{};
 
-    // 输入张量信息
-    std::cout << "\n[INPUT TENSORS]" << std::endl;
-    std::cout << std::string(50, '-') << std::endl;
+    size_t io_attr_bytes = 0;
+    for (const auto& attr : input_attrs_)
+    {
+        io_attr_bytes += attr.size_with_stride > 0 ? attr.size_with_stride : attr.size;
+    }
+    for (const auto& attr : output_attrs_)
+    {
+        io_attr_bytes += attr.size_with_stride > 0 ? attr.size_with_stride : attr.size;
+    }
 
-    for (size_t i = 0; i < input_attrs_.size(); i++)
+    rknn_mem_size mem_size;
+    memset(&mem_size, 0, sizeof(mem_size));
+    int ret = rknn_query(rknn_ctx_, RKNN_QUERY_MEM_SIZE, &mem_size, sizeof(mem_size));
+    if (ret == RKNN_SUCC)
     {
-        const auto& attr = input_attrs_[i];
-        std::cout << "Input[" << i << "]: " << (attr.name ? attr.name : "unnamed") << std::endl;
-        std::cout << "  Index      : " << attr.index << std::endl;
-        std::cout << "  Dimensions : ";
-        for (uint32_t j = 0; j < attr.n_dims; j++)
+        memory_usage_.weight_bytes = mem_size.total_weight_size;
+        size_t internal_sram = std::min<size_t>(sram_bytes_, mem_size.total_internal_size);
+        memory_usage_.internal_bytes = mem_size.total_internal_size - internal_sram;
+        // 共享分组的中间层内存由分组记入MemoryManager的共享部分（arena扩容时随之更新），不计入单个模型
+        if (scratch_group_)
         {
-            std::cout << attr.dims[j];
-            if (j < attr.n_dims - 1) std::cout << " x ";
+            memory_usage_.internal_bytes = 0;
         }
-        std::cout << " (" << attr.n_dims << "D)" << std::endl;
-        std::cout << "  Elements   : " << attr.n_elems << std::endl;
-        std::cout << "  Size       : " << attr.size << " bytes" << std::endl;
-        std::cout << "  Format     : " << get_format_string(attr.fmt) << std::endl;
-        std::cout << "  Type       : " << get_type_string(attr.type) << std::endl;
-        std::cout << "  Quant Type : " << get_qnt_type_string(attr.qnt_type) << std::endl;
+        memory_usage_.sram_bytes = sram_bytes_;
+        // 运行时分配的DMA内存中除权重与中间层外的部分为输入输出
+        uint64_t known = static_cast<uint64_t>(mem_size.total_weight_size) + mem_size.total_internal_size;
+        memory_usage_.io_bytes = mem_size.total_dma_allocated_size > known
+                                     ? static_cast<size_t>(mem_size.total_dma_allocated_size - known)
+                                     : io_attr_bytes;
+    }
+    else
+    {
+        std::cerr << "rknn_query(RKNN_QUERY_MEM_SIZE) failed! ret=" << ret << ", using tensor sizes" << std::endl;
+        memory_usage_.io_bytes = io_attr_bytes;
+    }
 
-        if (i < input_attrs_.size() - 1)
-        {
-            std::cout << std::string(30, '.') << std::endl;
-        }
+    // 主机侧：预分配输出、原生输入缓冲区，以及预处理图像（按模型输入尺寸估算）
+    size_t host = native_input_buffer_.capacity();
+    for (const auto& buffer : output_buffers_)
+    {
+        host += buffer.capacity();
+    }
+    host += static_cast<size_t>(model_width_) * model_height_ * model_channels_;
+    memory_usage_.host_bytes = host;
+}
+
+ModelMemoryUsage BaseModelImpl::getMemoryUsage() const
+{
+    return memory_usage_;
+}
+
+void BaseModelImpl::collectLayerPerf()
+{
+    rknn_perf_detail perf_detail;
+    memset(&perf_detail, 0, sizeof(perf_detail));
+    int ret = rknn_query(rknn_ctx_, RKNN_QUERY_PERF_DETAIL, &perf_detail, sizeof(perf_detail));
+    if (ret != RKNN_SUCC)
+    {
+        std::cerr << "rknn_query(RKNN_QUERY_PERF_DETAIL) failed! ret=" << ret << std::endl;
+        return;
+    }
+    if (parsePerfDetail(perf_detail.perf_data, layer_perf_))
+    {
+        layer_profiler_.accumulate(layer_perf_);
+    }
+}
+
+std::vector<LayerProfile> BaseModelImpl::getLayerProfile() const
+{
+    return layer_profiler_.profile();
+}
+
+void BaseModelImpl::resetLayerProfile()
+{
+    layer_profiler_.reset();
+}
+
+bool BaseModelImpl::isInitialized() const
+{
+    return initialized_;
+}
+
+int BaseModelImpl::getModelWidth() const
+{
+    return model_width_;
+}
+
+int BaseModelImpl::getModelHeight() const
+{
+    return model_height_;
+}
+
+int BaseModelImpl::getModelChannels() const
+{
+    return model_channels_;
+}
+
+cv::Size BaseModelImpl::getMaxInputSize() const
+{
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    return max_input_size_;
+}
+
+// ===== Protected 工具方法实现 =====
+
+bool BaseModelImpl::queryDynamicShapes(const ModelConfig& config)
+{
+    input_ranges_.clear();
+    dynamic_shapes_.clear();
+    current_shape_index_ = -1;
+    dynamic_shape_enabled_ = false;
+
+    input_ranges_.resize(io_num_.n_input);
+    for (uint32_t i = 0; i < io_num_.n_input; i++)
+    {
+        memset(&input_ranges_[i], 0, sizeof(rknn_input_range));
+        input_ranges_[i].index = i;
+        int ret = rknn_query(rknn_ctx_, RKNN_QUERY_INPUT_DYNAMIC_RANGE, &input_ranges_[i], sizeof(rknn_input_range));
+        if (ret != RKNN_SUCC || input_ranges_[i].shape_number == 0)
+        {
+            // 静态模型或运行时不支持该查询
+            input_ranges_.clear();
+            return true;
+        }
+    }
+
+    // 以第一个输入（图像）的shape列表作为候选尺寸
+    const auto& range = input_ranges_[0];
+    for (uint32_t k = 0; k < range.shape_number; k++)
+    {
+        const uint32_t* dims = range.dyn_range[k];
+        if (range.n_dims != 4)
+        {
+            continue;
+        }
+        if (range.fmt == RKNN_TENSOR_NCHW)
+        {
+            dynamic_shapes_.emplace_back(dims[3], dims[2]);
+        }
+        else
+        {
+            dynamic_shapes_.emplace_back(dims[2], dims[1]);
+        }
+    }
+    if (dynamic_shapes_.size() != range.shape_number)
+    {
+        std::cout << "[WARN] Unsupported dynamic input rank, using static shape" << std::endl;
+        input_ranges_.clear();
+        dynamic_shapes_.clear();
+        return true;
+    }
+
+    std::cout << "[INFO] Dynamic input shapes: " << dynamic_shapes_.size() << std::endl;
+    for (size_t k = 0; k < dynamic_shapes_.size(); k++)
+    {
+        std::cout << "       [" << k << "] " << dynamic_shapes_[k].width << " x " << dynamic_shapes_[k].height
+                  << std::endl;
+    }
+
+    dynamic_shape_enabled_ = getConfigBool(config, "dynamic_shape", true);
+
+    // 默认使用面积最大的shape，保证首帧前上下文已有合法输入尺寸
+    int largest = 0;
+    for (size_t k = 1; k < dynamic_shapes_.size(); k++)
+    {
+        if (dynamic_shapes_[k].area() > dynamic_shapes_[largest].area())
+        {
+            largest = static_cast<int>(k);
+        }
+    }
+    return applyInputShape(largest);
+}
+
+bool BaseModelImpl::selectInputShape(int src_width, int src_height)
+{
+    if (dynamic_shapes_.empty() || src_width <= 0 || src_height <= 0)
+    {
+        return true;
+    }
+
+    // 先求所有候选中letterbox可达到的最大缩放比例（即保留的最高分辨率），
+    // 再在达到该比例的候选中选面积最小的，从而去掉多余的padding
+    std::vector<float> scales(dynamic_shapes_.size());
+    float best_scale = 0.0f;
+    for (size_t k = 0; k < dynamic_shapes_.size(); k++)
+    {
+        scales[k] = std::min(static_cast<float>(dynamic_shapes_[k].width) / src_width,
+                             static_cast<float>(dynamic_shapes_[k].height) / src_height);
+        best_scale = std::max(best_scale, scales[k]);
+    }
+
+    int selected = -1;
+    for (size_t k = 0; k < dynamic_shapes_.size(); k++)
+    {
+        if (scales[k] < best_scale * 0.999f)
+        {
+            continue;
+        }
+        if (selected < 0 || dynamic_shapes_[k].area() < dynamic_shapes_[selected].area())
+        {
+            selected = static_cast<int>(k);
+        }
+    }
+
+    if (selected == current_shape_index_)
+    {
+        return true;
+    }
+    return applyInputShape(selected);
+}
+
+bool BaseModelImpl::applyInputShape(int shape_index)
+{
+    if (shape_index < 0 || shape_index >= static_cast<int>(dynamic_shapes_.size()))
+    {
+        return false;
+    }
+
+    // 所有输入按同一shape序号切换
+    std::vector<rknn_tensor_attr> attrs = input_attrs_;
+    for (uint32_t i = 0; i < io_num_.n_input; i++)
+    {
+        const auto& range = input_ranges_[i];
+        attrs[i].n_dims = range.n_dims;
+        attrs[i].fmt = range.fmt;
+        memcpy(attrs[i].dims, range.dyn_range[shape_index], range.n_dims * sizeof(uint32_t));
+    }
+
+    int ret = rknn_set_input_shapes(rknn_ctx_, io_num_.n_input, attrs.data());
+    if (ret != RKNN_SUCC)
+    {
+        std::cerr << "rknn_set_input_shapes failed! ret=" << ret << std::endl;
+        return false;
+    }
+
+    // 重新读取当前输入输出属性，输出网格尺寸会随输入shape变化
+    for (uint32_t i = 0; i < io_num_.n_input; i++)
+    {
+        input_attrs_[i].index = i;
+        ret = rknn_query(rknn_ctx_, RKNN_QUERY_CURRENT_INPUT_ATTR, &input_attrs_[i], sizeof(rknn_tensor_attr));
+        if (ret != RKNN_SUCC)
+        {
+            std::cerr << "rknn_query RKNN_QUERY_CURRENT_INPUT_ATTR failed! ret=" << ret << std::endl;
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < io_num_.n_output; i++)
+    {
+        output_attrs_[i].index = i;
+        ret = rknn_query(rknn_ctx_, RKNN_QUERY_CURRENT_OUTPUT_ATTR, &output_attrs_[i], sizeof(rknn_tensor_attr));
+        if (ret != RKNN_SUCC)
+        {
+            std::cerr << "rknn_query RKNN_QUERY_CURRENT_OUTPUT_ATTR failed! ret=" << ret << std::endl;
+            return false;
+        }
+    }
+
+    current_shape_index_ = shape_index;
+    updateModelInputDims();
+    if (!outputs_.empty() && !allocateOutputBuffers())
+    {
+        return false;
+    }
+    if (native_input_enabled_ && !queryNativeInputAttrs(true))
+    {
+        return false;
+    }
+    std::cout << "[INFO] Input shape set to " << model_width_ << " x " << model_height_ << std::endl;
+    return true;
+}
+
+bool BaseModelImpl::queryNativeInputAttrs(bool current_shape)
+{
+    rknn_query_cmd cmd = current_shape ? RKNN_QUERY_CURRENT_NATIVE_INPUT_ATTR : RKNN_QUERY_NATIVE_INPUT_ATTR;
+    native_input_attrs_.resize(io_num_.n_input);
+    for (uint32_t i = 0; i < io_num_.n_input; i++)
+    {
+        memset(&native_input_attrs_[i], 0, sizeof(rknn_tensor_attr));
+        native_input_attrs_[i].index = i;
+        int ret = rknn_query(rknn_ctx_, cmd, &native_input_attrs_[i], sizeof(rknn_tensor_attr));
+        if (ret != RKNN_SUCC)
+        {
+            std::cerr << "rknn_query native input attr failed! ret=" << ret << std::endl;
+            native_input_attrs_.clear();
+            return false;
+        }
+    }
+
+    if (native_input_enabled_)
+    {
+        // 原生布局的填充区域须为零点（即实数0），预先整体填充一次
+        const auto& attr = native_input_attrs_[0];
+        size_t size = attr.size_with_stride > 0 ? attr.size_with_stride : attr.size;
+        if (!native_input_buffer_.resize(size))
+        {
+            std::cerr << "Failed to allocate native input buffer" << std::endl;
+            return false;
+        }
+        native_input_buffer_.fill(static_cast<uint8_t>(attr.zp));
+    }
+    return true;
+}
+
+bool BaseModelImpl::setupNativeInput(const ModelConfig& config)
+{
+    native_input_enabled_ = false;
+    if (!getConfigBool(config, "native_input", false))
+    {
+        return true;
+    }
+
+    const auto& attr = input_attrs_[0];
+    if (io_num_.n_input != 1 || attr.type != RKNN_TENSOR_INT8 || attr.qnt_type != RKNN_TENSOR_QNT_AFFINE_ASYMMETRIC ||
+        model_channels_ <= 0 || model_channels_ > InputQuantParams::kMaxChannels)
+    {
+        std::cout << "[WARN] native_input requires a single int8 affine-quantized image input, disabled" << std::endl;
+        return true;
+    }
+    // pass_through跳过了运行时的归一化，均值/方差须与模型转换时的配置一致。
+    // 多数模型转换时std为255或使用ImageNet均值/方差，默认值0/1会静默得到错误的输入，因此必须显式给出
+    if (config.find("input_mean") == config.end() || config.find("input_std") == config.end())
+    {
+        std::cout << "[WARN] native_input requires input_mean and input_std (as used at model conversion), disabled"
+                  << std::endl;
+        return true;
+    }
+
+    native_input_enabled_ = true;
+    if (!queryNativeInputAttrs(current_shape_index_ >= 0))
+    {
+        native_input_enabled_ = false;
+        return false;
+    }
+    const auto& native = native_input_attrs_[0];
+    if (native.fmt != RKNN_TENSOR_NHWC && native.fmt != RKNN_TENSOR_NC1HWC2)
+    {
+        std::cout << "[WARN] Unsupported native input format " << get_format_string(native.fmt)
+                  << ", native_input disabled" << std::endl;
+        native_input_enabled_ = false;
+        native_input_buffer_.release();
+        return true;
+    }
+
+    std::vector<float> mean = getConfigFloatList(config, "input_mean", model_channels_, 0.0f);
+    std::vector<float> stdv = getConfigFloatList(config, "input_std", model_channels_, 1.0f);
+    native_quant_ = makeInputQuantParams(model_channels_, mean.data(), stdv.data(), native.zp, native.scale);
+
+    std::cout << "[INFO] Native input: " << get_format_string(native.fmt) << ", zp=" << native.zp
+              << ", scale=" << native.scale << ", " << native_input_buffer_.size() << " bytes" << std::endl;
+    return true;
+}
+
+bool BaseModelImpl::allocateOutputBuffers()
+{
+    // 缓冲区只增不减：动态shape切换到更小的输出时沿用已有内存
+    outputs_.resize(io_num_.n_output);
+    output_buffers_.resize(io_num_.n_output);
+    for (uint32_t i = 0; i < io_num_.n_output; i++)
+    {
+        if (!output_buffers_[i].resize(output_attrs_[i].size))
+        {
+            return false;
+        }
+        memset(&outputs_[i], 0, sizeof(rknn_output));
+        outputs_[i].index = i;
+        outputs_[i].want_float = 0;
+        outputs_[i].is_prealloc = 1;
+        outputs_[i].buf = output_buffers_[i].data();
+        outputs_[i].size = output_attrs_[i].size;
+    }
+    return true;
+}
+
+void BaseModelImpl::updateModelInputDims()
+{
+    if (io_num_.n_input == 0)
+    {
+        return;
+    }
+    const auto& input_attr = input_attrs_[0];
+    if (input_attr.n_dims == 4)
+    {  // NHWC or NCHW
+        if (input_attr.fmt == RKNN_TENSOR_NHWC)
+        {
+            model_height_ = input_attr.dims[1];
+            model_width_ = input_attr.dims[2];
+            model_channels_ = input_attr.dims[3];
+        }
+        else if (input_attr.fmt == RKNN_TENSOR_NCHW)
+        {
+            model_channels_ = input_attr.dims[1];
+            model_height_ = input_attr.dims[2];
+            model_width_ = input_attr.dims[3];
+        }
+    }
+}
+
+bool BaseModelImpl::setupInternalMemory(const ModelConfig& config, uint32_t init_flags)
+{
+    if ((init_flags & RKNN_FLAG_INTERNAL_ALLOC_OUTSIDE) == 0)
+    {
+        return true;
+    }
+
+    rknn_mem_size mem_size;
+    memset(&mem_size, 0, sizeof(mem_size));
+    int ret = rknn_query(rknn_ctx_, RKNN_QUERY_MEM_SIZE, &mem_size, sizeof(mem_size));
+    if (ret != RKNN_SUCC)
+    {
+        std::cerr << "rknn_query(RKNN_QUERY_MEM_SIZE) failed! ret=" << ret << std::endl;
+        return false;
+    }
+
+    // 分组共享：组内使用同一块按最大模型分配的中间层内存
+    auto group_it = config.find("scratch_group");
+    if (group_it != config.end() && !group_it->second.empty())
+    {
+        if ((init_flags & RKNN_FLAG_ENABLE_SRAM) != 0)
+        {
+            std::cout << "[SCRATCH] scratch_group shares a DRAM arena, enable_sram ignored for internal memory"
+                      << std::endl;
+        }
+        scratch_group_ = ScratchGroup::get(group_it->second);
+        if (!scratch_group_->join(rknn_ctx_, mem_size.total_internal_size))
+        {
+            scratch_group_.reset();
+            return false;
+        }
+        return true;
+    }
+
+    // 按配额与剩余SRAM整体授予，放不下的模型中间层全部使用DRAM
+    uint64_t alloc_flags = RKNN_FLAG_MEMORY_FLAGS_DEFAULT;
+    if ((init_flags & RKNN_FLAG_ENABLE_SRAM) != 0)
+    {
+        size_t quota = static_cast<size_t>(getConfigInt(config, "sram_quota_kb", 0)) << 10;
+        if (MemoryManager::instance().acquireSram(this, mem_size.total_internal_size, quota, mem_size.total_sram_size))
+        {
+            alloc_flags |= RKNN_FLAG_MEMORY_TRY_ALLOC_SRAM;
+        }
+    }
+
+    internal_mem_ = rknn_create_mem2(rknn_ctx_, mem_size.total_internal_size, alloc_flags);
+    if (internal_mem_ == nullptr)
+    {
+        std::cerr << "rknn_create_mem2 failed for internal memory (" << mem_size.total_internal_size << " bytes)"
+                  << std::endl;
+        return false;
+    }
+    ret = rknn_set_internal_mem(rknn_ctx_, internal_mem_);
+    if (ret < 0)
+    {
+        std::cerr << "rknn_set_internal_mem failed! ret=" << ret << std::endl;
+        return false;
+    }
+
+    // 以分配前后的剩余SRAM之差作为实际落在SRAM中的大小
+    uint32_t free_sram_before = mem_size.free_sram_size;
+    sram_bytes_ = 0;
+    if (rknn_query(rknn_ctx_, RKNN_QUERY_MEM_SIZE, &mem_size, sizeof(mem_size)) == RKNN_SUCC &&
+        free_sram_before > mem_size.free_sram_size)
+    {
+        sram_bytes_ = free_sram_before - mem_size.free_sram_size;
+    }
+    std::cout << "[SRAM] Internal memory: " << (mem_size.total_internal_size >> 10) << " KB, in SRAM: "
+              << (sram_bytes_ >> 10) << " KB (system SRAM " << (mem_size.total_sram_size >> 10) << " KB, free "
+              << (mem_size.free_sram_size >> 10) << " KB)" << std::endl;
+    return true;
+}
+
+uint32_t BaseModelImpl::getInitFlags(const ModelConfig& config)
+{
+    uint32_t flags = 0;
+    if (getConfigBool(config, "enable_profiling", false))
+    {
+        flags |= RKNN_FLAG_COLLECT_PERF_MASK;
+    }
+    // 驱动层优先级：与NpuScheduler的排队优先级一致
+    auto priority_it = config.find("priority");
+    if (priority_it != config.end())
+    {
+        switch (NpuScheduler::parsePriority(priority_it->second))
+        {
+            case NpuPriority::HIGH:
+                flags |= RKNN_FLAG_PRIOR_HIGH;
+                break;
+            case NpuPriority::LOW:
+                flags |= RKNN_FLAG_PRIOR_LOW;
+                break;
+            default:
+                flags |= RKNN_FLAG_PRIOR_MEDIUM;
+                break;
+        }
+    }
+    auto group_it = config.find("scratch_group");
+    if (group_it != config.end() && !group_it->second.empty())
+    {
+        flags |= RKNN_FLAG_INTERNAL_ALLOC_OUTSIDE;
+    }
+    // SRAM：中间层内存改为外部分配，以便通过rknn_create_mem2优先放入SRAM并按配额记账
+    if (getConfigBool(config, "enable_sram", false))
+    {
+        flags |= RKNN_FLAG_ENABLE_SRAM | RKNN_FLAG_INTERNAL_ALLOC_OUTSIDE;
+        if (getConfigBool(config, "share_sram", false))
+        {
+            flags |= RKNN_FLAG_SHARE_SRAM;
+        }
+    }
+    return flags;
+}
+
+bool BaseModelImpl::loadRKNNModel(const std::string& model_path, uint32_t init_flags)
+{
+    // 1. 读取模型文件
+    std::ifstream file(model_path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        std::cerr << "Cannot open model file: " << model_path << std::endl;
+        return false;
+    }
+
+    size_t model_size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<char> model_data(model_size);
+    if (!file.read(model_data.data(), model_size))
+    {
+        std::cerr << "Failed to read model file" << std::endl;
+        return false;
+    }
+    file.close();
+
+    std::cout << "[INFO] Model file size: " << model_size << " bytes" << std::endl;
+
+    // 2. 初始化RKNN
+    int ret = rknn_init(&rknn_ctx_, model_data.data(), model_size, init_flags, nullptr);
+    if (ret < 0)
+    {
+        std::cerr << "rknn_init failed! ret=" << ret << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BaseModelImpl::runRKNNInference(const cv::Mat& input_img)
+{
+    if (io_num_.n_input != 1)
+    {
+        std::cerr << "Model has " << io_num_.n_input << " inputs, use predictTensors() to feed all of them"
+                  << std::endl;
+        return false;
+    }
+
+    // 验证图像尺寸
+    if (input_img.cols != model_width_ || input_img.rows != model_height_ ||
+        input_img.channels() != getModelChannels())
+    {
+        std::cerr << "Image dimension mismatch: expected " << model_width_ << "x" << model_height_ << "x"
+                  << model_channels_ << ", got " << input_img.cols << "x" << input_img.rows << "x"
+                  << input_img.channels() << std::endl;
+        return false;
+    }
+
+    // 运行时要求数据连续
+    cv::Mat rgb_img = input_img.isContinuous() ? input_img : input_img.clone();
+
+    if (image_input_.empty())
+    {
+        image_input_.resize(1);
+        image_input_[0].index = 0;
+    }
+
+    if (native_input_enabled_)
+    {
+        // 原生布局输入：在CPU上一次完成量化与排布，运行时不再转换
+        RKNN_TRACE_SCOPE("quantize_input");
+        const auto& native = native_input_attrs_[0];
+        int w_stride = native.w_stride > 0 ? static_cast<int>(native.w_stride) : model_width_;
+        if (native.fmt == RKNN_TENSOR_NC1HWC2)
+        {
+            quantizeU8ToI8NC1HWC2(rgb_img.data, model_height_, model_width_, native_quant_,
+                                  static_cast<int>(native.dims[4]), w_stride,
+                                  reinterpret_cast<int8_t*>(native_input_buffer_.data()));
+        }
+        else
+        {
+            quantizeU8ToI8NHWC(rgb_img.data, model_height_, model_width_, native_quant_, w_stride,
+                               reinterpret_cast<int8_t*>(native_input_buffer_.data()));
+        }
+        image_input_[0].type = TensorType::INT8;
+        image_input_[0].layout = TensorLayout::NHWC;
+        image_input_[0].pass_through = true;
+        image_input_[0].data = native_input_buffer_.data();
+        image_input_[0].size = native_input_buffer_.size();
+    }
+    else
+    {
+        // 图像输入：uint8 NHWC，由运行时转换为模型输入格式
+        image_input_[0].type = TensorType::UINT8;
+        image_input_[0].layout = TensorLayout::NHWC;
+        image_input_[0].pass_through = false;
+        image_input_[0].data = rgb_img.data;
+        image_input_[0].size = rgb_img.total() * rgb_img.elemSize();
+    }
+
+    return runRKNNInference(image_input_);
+}
+
+static rknn_tensor_type toRKNNType(TensorType type)
+{
+    switch (type)
+    {
+        case TensorType::INT8:
+            return RKNN_TENSOR_INT8;
+        case TensorType::FLOAT16:
+            return RKNN_TENSOR_FLOAT16;
+        case TensorType::FLOAT32:
+            return RKNN_TENSOR_FLOAT32;
+        case TensorType::UINT8:
+        default:
+            return RKNN_TENSOR_UINT8;
+    }
+}
+
+static rknn_tensor_format toRKNNFormat(TensorLayout layout)
+{
+    switch (layout)
+    {
+        case TensorLayout::NCHW:
+            return RKNN_TENSOR_NCHW;
+        case TensorLayout::UNDEFINED:
+            return RKNN_TENSOR_UNDEFINED;
+        case TensorLayout::NHWC:
+        default:
+            return RKNN_TENSOR_NHWC;
+    }
+}
+
+static size_t getTensorTypeSize(TensorType type)
+{
+    switch (type)
+    {
+        case TensorType::FLOAT16:
+            return 2;
+        case TensorType::FLOAT32:
+            return 4;
+        case TensorType::UINT8:
+        case TensorType::INT8:
+        default:
+            return 1;
+    }
+}
+
+// 除数据指针外的输入描述是否一致，一致时可跳过校验
+static bool isSameBinding(const std::vector<InputTensor>& a, const std::vector<InputTensor>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].name != b[i].name || a[i].index != b[i].index || a[i].size != b[i].size || a[i].type != b[i].type ||
+            a[i].layout != b[i].layout || a[i].pass_through != b[i].pass_through)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BaseModelImpl::setInputTensors(const std::vector<InputTensor>& tensors)
+{
+    if (!isSameBinding(tensors, bound_inputs_))
+    {
+        // 输入描述变化：按input_attrs_重新校验并构建rknn_input数组
+        if (tensors.size() != io_num_.n_input)
+        {
+            std::cerr << "Input count mismatch: model expects " << io_num_.n_input << ", got " << tensors.size()
+                      << std::endl;
+            return false;
+        }
+
+        std::vector<rknn_input> inputs(io_num_.n_input);
+        std::vector<int> binding;
+        std::vector<bool> assigned(io_num_.n_input, false);
+        memset(inputs.data(), 0, inputs.size() * sizeof(rknn_input));
+
+        for (const auto& tensor : tensors)
+        {
+            int index = tensor.index;
+            if (!tensor.name.empty())
+            {
+                index = -1;
+                for (uint32_t i = 0; i < io_num_.n_input; i++)
+                {
+                    if (tensor.name == input_attrs_[i].name)
+                    {
+                        index = static_cast<int>(i);
+                        break;
+                    }
+                }
+            }
+            if (index < 0 || index >= static_cast<int>(io_num_.n_input))
+            {
+                std::cerr << "Unknown model input: "
+                          << (tensor.name.empty() ? std::to_string(tensor.index) : tensor.name) << std::endl;
+                return false;
+            }
+            if (assigned[index])
+            {
+                std::cerr << "Model input " << index << " specified more than once" << std::endl;
+                return false;
+            }
+
+            // pass_through数据须为模型输入或其原生布局的字节数，否则按元素数与数据类型计算
+            const auto& attr = input_attrs_[index];
+            size_t expected = attr.n_elems * getTensorTypeSize(tensor.type);
+            if (tensor.pass_through)
+            {
+                expected = attr.size;
+                if (index < static_cast<int>(native_input_attrs_.size()))
+                {
+                    const auto& native = native_input_attrs_[index];
+                    size_t native_size = native.size_with_stride > 0 ? native.size_with_stride : native.size;
+                    if (tensor.size == native_size)
+                    {
+                        expected = native_size;
+                    }
+                }
+            }
+            if (tensor.size != expected)
+            {
+                std::cerr << "Input " << index << " size mismatch: expected " << expected << " bytes, got "
+                          << tensor.size << std::endl;
+                return false;
+            }
+
+            assigned[index] = true;
+            binding.push_back(index);
+            inputs[index].index = index;
+            inputs[index].size = static_cast<uint32_t>(tensor.size);
+            inputs[index].pass_through = tensor.pass_through ? 1 : 0;
+            inputs[index].type = toRKNNType(tensor.type);
+            inputs[index].fmt = toRKNNFormat(tensor.layout);
+        }
+
+        inputs_.swap(inputs);
+        input_binding_.swap(binding);
+        bound_inputs_ = tensors;
+    }
+
+    // 仅更新数据指针
+    for (size_t i = 0; i < tensors.size(); i++)
+    {
+        inputs_[input_binding_[i]].buf = const_cast<void*>(tensors[i].data);
+    }
+
+    RKNN_TRACE_SCOPE("rknn_inputs_set");
+    int ret = rknn_inputs_set(rknn_ctx_, io_num_.n_input, inputs_.data());
+    if (ret < 0)
+    {
+        std::cerr << "rknn_inputs_set failed! ret=" << ret << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BaseModelImpl::runRKNNInference(const std::vector<InputTensor>& tensors)
+{
+    // 1. 设置输入
+    if (!setInputTensors(tensors))
+    {
+        return false;
+    }
+
+    // 2. 启用调度时先向NpuScheduler申请NPU，已错过截止时间的请求不再执行
+    if (!use_scheduler_)
+    {
+        return runAndFetchOutputs();
+    }
+    NpuScheduler& scheduler = NpuScheduler::instance();
+    NpuScheduler::Clock::time_point deadline = deadline_ms_ > 0 && !warming_up_
+                                                   ? request_start_ + std::chrono::milliseconds(deadline_ms_)
+                                                   : NpuScheduler::Clock::time_point::max();
+    bool granted;
+    {
+        RKNN_TRACE_SCOPE("npu_queue");
+        granted = scheduler.acquire(this, getModelName(), npu_priority_, deadline);
+    }
+    if (!granted)
+    {
+        std::cerr << "[SCHED] Request dropped: deadline " << deadline_ms_ << " ms missed before reaching NPU"
+                  << std::endl;
+        return false;
+    }
+    bool ok = runAndFetchOutputs();
+    scheduler.release(this);
+    return ok;
+}
+
+bool BaseModelImpl::runAndFetchOutputs()
+{
+    // 1. 执行推理：共享中间层内存的分组内同一时刻只允许一个模型运行
+    std::unique_lock<std::mutex> scratch_lock;
+    if (scratch_group_)
+    {
+        scratch_lock = std::unique_lock<std::mutex>(scratch_group_->runMutex());
+    }
+    int ret;
+    {
+        RKNN_TRACE_SCOPE("rknn_run");
+        ret = rknn_run(rknn_ctx_, nullptr);
+    }
+    if (ret < 0)
+    {
+        std::cerr << "rknn_run failed! ret=" << ret << std::endl;
+        return false;
+    }
+    if (profiling_enabled_)
+    {
+        collectLayerPerf();
+    }
+
+    // 2. 获取输出 - 写入预分配缓冲区，保持模型原始数据类型，由后处理按需转换（见readOutputAsFloat）
+    {
+        RKNN_TRACE_SCOPE("rknn_outputs_get");
+        ret = rknn_outputs_get(rknn_ctx_, io_num_.n_output, outputs_.data(), nullptr);
+    }
+    if (ret < 0)
+    {
+        std::cerr << "rknn_outputs_get failed! ret=" << ret << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BaseModelImpl::readOutputAsFloat(const rknn_output& output, int index, size_t offset, size_t count,
+                                      size_t stride, float* dst) const
+{
+    if (index < 0 || index >= static_cast<int>(output_attrs_.size()) || output.buf == nullptr)
+    {
+        return false;
+    }
+    const auto& attr = output_attrs_[index];
+    if (count > 0 && offset + (count - 1) * stride >= attr.n_elems)
+    {
+        std::cerr << "Output " << index << " read out of range" << std::endl;
+        return false;
+    }
+
+    // 量化参数：仿射量化使用zp/scale，DFP换算为scale=2^-fl，无量化时为恒等
+    int32_t zp = 0;
+    float scale = 1.0f;
+    if (attr.qnt_type == RKNN_TENSOR_QNT_AFFINE_ASYMMETRIC)
+    {
+        zp = attr.zp;
+        scale = attr.scale;
+    }
+    else if (attr.qnt_type == RKNN_TENSOR_QNT_DFP)
+    {
+        scale = std::ldexp(1.0f, -attr.fl);
+    }
+
+    switch (attr.type)
+    {
+        case RKNN_TENSOR_INT8:
+        {
+            const int8_t* src = static_cast<const int8_t*>(output.buf) + offset;
+            if (stride == 1)
+            {
+                dequantizeI8ToF32(src, count, zp, scale, dst);
+            }
+            else
+            {
+                gatherI8ToF32(src, stride, count, zp, scale, dst);
+            }
+            return true;
+        }
+        case RKNN_TENSOR_UINT8:
+        {
+            const uint8_t* src = static_cast<const uint8_t*>(output.buf) + offset;
+            if (stride == 1)
+            {
+                dequantizeU8ToF32(src, count, zp, scale, dst);
+            }
+            else
+            {
+                gatherU8ToF32(src, stride, count, zp, scale, dst);
+            }
+            return true;
+        }
+        case RKNN_TENSOR_FLOAT16:
+        {
+            const uint16_t* src = static_cast<const uint16_t*>(output.buf) + offset;
+            if (stride == 1)
+            {
+                convertF16ToF32(src, count, dst);
+            }
+            else
+            {
+                gatherF16ToF32(src, stride, count, dst);
+            }
+            return true;
+        }
+        case RKNN_TENSOR_FLOAT32:
+        {
+            gatherF32(static_cast<const float*>(output.buf) + offset, stride, count, dst);
+            return true;
+        }
+        default:
+            std::cerr << "Unsupported output type: " << get_type_string(attr.type) << std::endl;
+            return false;
+    }
+}
+
+void BaseModelImpl::dumpTensorAttrs() const
+{
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "                           MODEL TENSOR INFORMATION" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+
+    // 输入张量信息
+    std::cout << "\n[INPUT TENSORS]" << std::endl;
+    std::cout << std::string(50, '-') << std::endl;
+
+    for (size_t i = 0; i < input_attrs_.size(); i++)
+    {
+        const auto& attr = input_attrs_[i];
+        std::cout << "Input[" << i << "]: " << (attr.name ? attr.name : "unnamed") << std::endl;
+        std::cout << "  Index      : " << attr.index << std::endl;
+        std::cout << "  Dimensions : ";
+        for (uint32_t j = 0; j < attr.n_dims; j++)
+        {
+            std::cout << attr.dims[j];
+            if (j < attr.n_dims - 1) std::cout << " x ";
+        }
+        std::cout << " (" << attr.n_dims << "D)" << std::endl;
+        std::cout << "  Elements   : " << attr.n_elems << std::endl;
+        std::cout << "  Size       : " << attr.size << " bytes" << std::endl;
+        std::cout << "  Format     : " << get_format_string(attr.fmt) << std::endl;
+        std::cout << "  Type       : " << get_type_string(attr.type) << std::endl;
+        std::cout << "  Quant Type : " << get_qnt_type_string(attr.qnt_type) << std::endl;
+
+        if (i < input_attrs_.size() - 1)
+        {
+            std::cout << std::string(30, '.') << std::endl;
+        }
     }
 
     // 输出张量信息
@@ -401,6 +1683,53 @@ void BaseModelImpl::dumpTensorAttrs() const
 
 // ===== 便利方法实现 =====
 
+std::vector<float> BaseModelImpl::getConfigFloatList(const ModelConfig& config, const std::string& key, size_t count,
+                                                     float default_value)
+{
+    // 逗号分隔的数值列表，只给出一个值时应用到全部元素
+    std::vector<float> values;
+    auto it = config.find(key);
+    if (it != config.end())
+    {
+        std::stringstream ss(it->second);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            if (!item.empty())
+            {
+                values.push_back(std::stof(item));
+            }
+        }
+    }
+    if (values.empty())
+    {
+        values.push_back(default_value);
+    }
+    values.resize(count, values.back());
+    return values;
+}
+
+int BaseModelImpl::getConfigInt(const ModelConfig& config, const std::string& key, int default_value)
+{
+    auto it = config.find(key);
+    if (it == config.end() || it->second.empty())
+    {
+        return default_value;
+    }
+    return std::stoi(it->second);
+}
+
+bool BaseModelImpl::getConfigBool(const ModelConfig& config, const std::string& key, bool default_value)
+{
+    auto it = config.find(key);
+    if (it == config.end() || it->second.empty())
+    {
+        return default_value;
+    }
+    const std::string& value = it->second;
+    return value == "1" || value == "true" || value == "on" || value == "yes";
+}
+
 InferenceResult BaseModelImpl::createDetectionResult(const DetectionResults& detections) const
 {
     InferenceResult result;
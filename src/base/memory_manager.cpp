@@ -0,0 +1,253 @@
+#include "rknn_cpp/base/memory_manager.h"
+#include "rknn_cpp/base/base_model_impl.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace rknn_cpp
+{
+
+static double toMB(size_t bytes)
+{
+    return bytes / 1048576.0;
+}
+
+MemoryManager& MemoryManager::instance()
+{
+    static MemoryManager manager;
+    return manager;
+}
+
+void MemoryManager::setBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = bytes;
+}
+
+size_t MemoryManager::getBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+size_t MemoryManager::getUsedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usedLocked(nullptr);
+}
+
+MemoryManager::Entry* MemoryManager::findLocked(BaseModelImpl* model)
+{
+    for (auto& entry : entries_)
+    {
+        if (entry.model == model)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool MemoryManager::reserveSharedBytes(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!makeRoomLocked(nullptr, bytes))
+    {
+        return false;
+    }
+    shared_bytes_.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    return true;
+}
+
+void MemoryManager::addSharedBytes(int64_t delta)
+{
+    shared_bytes_.fetch_add(delta, std::memory_order_relaxed);
+}
+
+size_t MemoryManager::getSharedBytes() const
+{
+    return static_cast<size_t>(std::max<int64_t>(0, shared_bytes_.load(std::memory_order_relaxed)));
+}
+
+size_t MemoryManager::usedLocked(const BaseModelImpl* exclude) const
+{
+    size_t used = getSharedBytes();
+    for (const auto& entry : entries_)
+    {
+        if (entry.model != exclude)
+        {
+            used += entry.account.bytes;
+        }
+    }
+    return used;
+}
+
+bool MemoryManager::makeRoomLocked(BaseModelImpl* requester, size_t bytes)
+{
+    if (budget_ == 0)
+    {
+        return true;
+    }
+
+    std::vector<BaseModelImpl*> busy;
+    while (usedLocked(requester) + bytes > budget_)
+    {
+        // 选择最久未使用且已加载完成的模型，推理中的模型跳过
+        Entry* victim = nullptr;
+        for (auto& entry : entries_)
+        {
+            if (entry.model == requester || !entry.account.loaded ||
+                std::find(busy.begin(), busy.end(), entry.model) != busy.end())
+            {
+                continue;
+            }
+            if (victim == nullptr || entry.model->getLastUsed() < victim->model->getLastUsed())
+            {
+                victim = &entry;
+            }
+        }
+        if (victim == nullptr)
+        {
+            std::cerr << "[MEMORY] Budget exceeded: need " << toMB(usedLocked(requester) + bytes) << " MB, budget "
+                      << toMB(budget_) << " MB, no idle model to evict" << std::endl;
+            return false;
+        }
+
+        BaseModelImpl* model = victim->model;
+        if (!model->tryEvict())
+        {
+            busy.push_back(model);
+            continue;
+        }
+        std::cout << "[MEMORY] Evicted idle model " << victim->account.model_name << " ("
+                  << toMB(victim->account.bytes) << " MB), will reload on next predict" << std::endl;
+        entries_.erase(entries_.begin() + (victim - entries_.data()));
+    }
+    return true;
+}
+
+bool MemoryManager::reserve(BaseModelImpl* model, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!makeRoomLocked(model, bytes))
+    {
+        return false;
+    }
+    Entry* entry = findLocked(model);
+    if (entry == nullptr)
+    {
+        entries_.push_back({model, {"", bytes, 0, false}});
+    }
+    else
+    {
+        entry->account.bytes = bytes;
+        entry->account.sram_bytes = 0;
+        entry->account.loaded = false;
+    }
+    return true;
+}
+
+bool MemoryManager::commit(BaseModelImpl* model, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!makeRoomLocked(model, bytes))
+    {
+        return false;
+    }
+    Entry* entry = findLocked(model);
+    if (entry == nullptr)
+    {
+        entries_.push_back({model, {model->getModelName(), bytes, 0, true}});
+    }
+    else
+    {
+        entry->account.model_name = model->getModelName();
+        entry->account.bytes = bytes;
+        entry->account.loaded = true;
+    }
+    return true;
+}
+
+bool MemoryManager::acquireSram(BaseModelImpl* model, size_t bytes, size_t quota, size_t total_sram)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes == 0 || (quota > 0 && bytes > quota))
+    {
+        return false;
+    }
+    size_t used = 0;
+    for (const auto& entry : entries_)
+    {
+        if (entry.model != model)
+        {
+            used += entry.account.sram_bytes;
+        }
+    }
+    if (used + bytes > total_sram)
+    {
+        std::cout << "[SRAM] Not enough SRAM for " << (bytes >> 10) << " KB (used " << (used >> 10) << " / "
+                  << (total_sram >> 10) << " KB), using DRAM" << std::endl;
+        return false;
+    }
+
+    Entry* entry = findLocked(model);
+    if (entry == nullptr)
+    {
+        entries_.push_back({model, {"", 0, bytes, false}});
+    }
+    else
+    {
+        entry->account.sram_bytes = bytes;
+    }
+    return true;
+}
+
+void MemoryManager::unregister(BaseModelImpl* model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [model](const Entry& entry) { return entry.model == model; }),
+                   entries_.end());
+}
+
+std::vector<MemoryAccount> MemoryManager::getAccounts() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<MemoryAccount> accounts;
+    accounts.reserve(entries_.size());
+    for (const auto& entry : entries_)
+    {
+        accounts.push_back(entry.account);
+    }
+    return accounts;
+}
+
+void MemoryManager::printSummary() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::cout << "[MEMORY] Used " << std::fixed << std::setprecision(1) << toMB(usedLocked(nullptr)) << " MB";
+    if (budget_ > 0)
+    {
+        std::cout << " / budget " << toMB(budget_) << " MB";
+    }
+    std::cout << ", " << entries_.size() << " models";
+    if (getSharedBytes() > 0)
+    {
+        std::cout << ", " << toMB(getSharedBytes()) << " MB shared";
+    }
+    std::cout << std::endl;
+    for (const auto& entry : entries_)
+    {
+        std::cout << "         " << std::left << std::setw(16)
+                  << (entry.account.model_name.empty() ? "(loading)" : entry.account.model_name) << std::right
+                  << std::setw(8) << toMB(entry.account.bytes) << " MB";
+        if (entry.account.sram_bytes > 0)
+        {
+            std::cout << " (+" << (entry.account.sram_bytes >> 10) << " KB SRAM)";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+}  // namespace rknn_cpp
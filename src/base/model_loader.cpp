@@ -0,0 +1,231 @@
+#include "rknn_cpp/base/model_loader.h"
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+static const char* stateName(ModelLoadState state)
+{
+    switch (state)
+    {
+        case ModelLoadState::LOADING:
+            return "loading";
+        case ModelLoadState::READY:
+            return "ready";
+        case ModelLoadState::FAILED:
+            return "failed";
+        default:
+            return "pending";
+    }
+}
+
+ModelGroupLoader::ModelGroupLoader(int max_parallel) : max_parallel_(max_parallel)
+{
+    if (max_parallel_ <= 0)
+    {
+        max_parallel_ = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+ModelGroupLoader::~ModelGroupLoader()
+{
+    for (auto& worker : workers_)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+void ModelGroupLoader::add(const std::string& name, IModel* model, const ModelConfig& config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_)
+    {
+        std::cerr << "ModelGroupLoader: cannot add '" << name << "' after start()" << std::endl;
+        return;
+    }
+    Item item;
+    item.model = model;
+    item.config = config;
+    item.status.name = name;
+    items_.push_back(std::move(item));
+}
+
+void ModelGroupLoader::setReadyCallback(ReadyCallback callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = std::move(callback);
+}
+
+void ModelGroupLoader::prefetchFiles() const
+{
+    // 只提示内核预读，不阻塞；失败不影响加载
+    for (const auto& item : items_)
+    {
+        auto it = item.config.find("model_path");
+        if (it == item.config.end())
+        {
+            continue;
+        }
+        int fd = open(it->second.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            continue;
+        }
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        close(fd);
+    }
+}
+
+void ModelGroupLoader::start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_)
+    {
+        return;
+    }
+    started_ = true;
+    prefetchFiles();
+
+    int workers = std::min(max_parallel_, static_cast<int>(items_.size()));
+    std::cout << "[LOADER] Loading " << items_.size() << " models with " << workers << " threads" << std::endl;
+    for (int i = 0; i < workers; i++)
+    {
+        workers_.emplace_back(&ModelGroupLoader::workerLoop, this);
+    }
+}
+
+void ModelGroupLoader::workerLoop()
+{
+    while (true)
+    {
+        // items_在start后不再增删，取出的下标在锁外使用是安全的
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (next_item_ >= items_.size())
+            {
+                return;
+            }
+            index = next_item_++;
+            items_[index].status.state = ModelLoadState::LOADING;
+        }
+
+        Item& item = items_[index];
+        auto start = std::chrono::steady_clock::now();
+        bool success = item.model->initialize(item.config);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        ReadyCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            item.status.state = success ? ModelLoadState::READY : ModelLoadState::FAILED;
+            item.status.load_ms = elapsed.count();
+            finished_++;
+            callback = callback_;
+        }
+        cond_.notify_all();
+        if (callback)
+        {
+            callback(item.status.name, success);
+        }
+    }
+}
+
+bool ModelGroupLoader::waitAll()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!started_)
+    {
+        std::cerr << "ModelGroupLoader: waitAll() called before start()" << std::endl;
+        return false;
+    }
+    cond_.wait(lock, [this]() { return finished_ >= items_.size(); });
+    return std::all_of(items_.begin(), items_.end(),
+                       [](const Item& item) { return item.status.state == ModelLoadState::READY; });
+}
+
+const ModelGroupLoader::Item* ModelGroupLoader::findLocked(const std::string& name) const
+{
+    for (const auto& item : items_)
+    {
+        if (item.status.name == name)
+        {
+            return &item;
+        }
+    }
+    return nullptr;
+}
+
+bool ModelGroupLoader::waitFor(const std::string& name, int timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    const Item* item = findLocked(name);
+    if (item == nullptr)
+    {
+        std::cerr << "ModelGroupLoader: unknown model '" << name << "'" << std::endl;
+        return false;
+    }
+    if (!started_)
+    {
+        std::cerr << "ModelGroupLoader: waitFor('" << name << "') called before start()" << std::endl;
+        return false;
+    }
+    auto done = [item]() {
+        return item->status.state == ModelLoadState::READY || item->status.state == ModelLoadState::FAILED;
+    };
+    if (timeout_ms < 0)
+    {
+        cond_.wait(lock, done);
+    }
+    else if (!cond_.wait_for(lock, std::chrono::milliseconds(timeout_ms), done))
+    {
+        return false;
+    }
+    return item->status.state == ModelLoadState::READY;
+}
+
+bool ModelGroupLoader::isReady(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Item* item = findLocked(name);
+    return item != nullptr && item->status.state == ModelLoadState::READY;
+}
+
+std::vector<ModelLoadStatus> ModelGroupLoader::getStatus() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ModelLoadStatus> status;
+    status.reserve(items_.size());
+    for (const auto& item : items_)
+    {
+        status.push_back(item.status);
+    }
+    return status;
+}
+
+void ModelGroupLoader::printSummary() const
+{
+    std::vector<ModelLoadStatus> status = getStatus();
+    std::cout << "[LOADER] " << status.size() << " models" << std::endl;
+    for (const auto& s : status)
+    {
+        std::cout << "         " << std::left << std::setw(16) << s.name << std::setw(10) << stateName(s.state)
+                  << std::right;
+        if (s.state == ModelLoadState::READY || s.state == ModelLoadState::FAILED)
+        {
+            std::cout << std::fixed << std::setprecision(1) << std::setw(10) << s.load_ms << " ms"
+                      << std::defaultfloat;
+        }
+        std::cout << std::endl;
+    }
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,183 @@
+#include "rknn_cpp/base/npu_scheduler.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace rknn_cpp
+{
+
+NpuScheduler& NpuScheduler::instance()
+{
+    static NpuScheduler scheduler;
+    return scheduler;
+}
+
+void NpuScheduler::setMaxConcurrent(int count)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_concurrent_ = std::max(1, count);
+    cond_.notify_all();
+}
+
+int NpuScheduler::getMaxConcurrent() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_concurrent_;
+}
+
+NpuScheduler::Entry& NpuScheduler::entryLocked(BaseModelImpl* model, const std::string& model_name,
+                                               NpuPriority priority)
+{
+    for (auto& entry : entries_)
+    {
+        if (entry.model == model)
+        {
+            entry.stats.priority = priority;
+            return entry;
+        }
+    }
+    Entry entry;
+    entry.model = model;
+    entry.stats.model_name = model_name;
+    entry.stats.priority = priority;
+    entries_.push_back(entry);
+    return entries_.back();
+}
+
+bool NpuScheduler::acquire(BaseModelImpl* model, const std::string& model_name, NpuPriority priority,
+                           Clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    Clock::time_point submit = Clock::now();
+    entryLocked(model, model_name, priority).stats.submitted++;
+
+    Request request{static_cast<int>(priority), deadline, next_seq_++};
+    auto it = pending_.insert(request).first;
+
+    // 队首且有空闲NPU时获得运行权；截止时间先到则放弃
+    bool granted = false;
+    while (true)
+    {
+        if (pending_.begin() == it && running_ < max_concurrent_)
+        {
+            granted = Clock::now() < deadline;
+            break;
+        }
+        if (deadline == Clock::time_point::max())
+        {
+            cond_.wait(lock);
+        }
+        else if (cond_.wait_until(lock, deadline) == std::cv_status::timeout)
+        {
+            break;
+        }
+    }
+    pending_.erase(it);
+
+    // entries_可能在等待期间扩容，重新查找
+    Entry& entry = entryLocked(model, model_name, priority);
+    if (!granted)
+    {
+        entry.stats.dropped++;
+        cond_.notify_all();  // 队首变化，唤醒后续请求
+        return false;
+    }
+
+    running_++;
+    entry.run_start = Clock::now();
+    double wait_us = std::chrono::duration<double, std::micro>(entry.run_start - submit).count();
+    entry.stats.total_wait_us += wait_us;
+    entry.stats.max_wait_us = std::max(entry.stats.max_wait_us, wait_us);
+    if (running_ < max_concurrent_)
+    {
+        cond_.notify_all();
+    }
+    return true;
+}
+
+void NpuScheduler::release(BaseModelImpl* model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_--;
+    for (auto& entry : entries_)
+    {
+        if (entry.model == model)
+        {
+            entry.stats.completed++;
+            entry.stats.total_run_us +=
+                std::chrono::duration<double, std::micro>(Clock::now() - entry.run_start).count();
+            break;
+        }
+    }
+    cond_.notify_all();
+}
+
+void NpuScheduler::unregister(BaseModelImpl* model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [model](const Entry& entry) { return entry.model == model; }),
+                   entries_.end());
+}
+
+std::vector<NpuQueueStats> NpuScheduler::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<NpuQueueStats> stats;
+    stats.reserve(entries_.size());
+    for (const auto& entry : entries_)
+    {
+        stats.push_back(entry.stats);
+    }
+    return stats;
+}
+
+void NpuScheduler::printSummary() const
+{
+    std::vector<NpuQueueStats> stats = getStats();
+    std::cout << "[SCHED] " << stats.size() << " models, max concurrent " << getMaxConcurrent() << std::endl;
+    std::cout << "         " << std::left << std::setw(16) << "Model" << std::setw(8) << "Prio" << std::right
+              << std::setw(10) << "Runs" << std::setw(10) << "Dropped" << std::setw(14) << "AvgWait(us)"
+              << std::setw(14) << "MaxWait(us)" << std::setw(14) << "AvgRun(us)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& s : stats)
+    {
+        std::cout << "         " << std::left << std::setw(16) << s.model_name << std::setw(8)
+                  << priorityName(s.priority) << std::right << std::setw(10) << s.completed << std::setw(10)
+                  << s.dropped << std::setw(14) << s.avgWaitUs() << std::setw(14) << s.max_wait_us << std::setw(14)
+                  << s.avgRunUs() << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+NpuPriority NpuScheduler::parsePriority(const std::string& value)
+{
+    if (value == "high")
+    {
+        return NpuPriority::HIGH;
+    }
+    if (value == "low")
+    {
+        return NpuPriority::LOW;
+    }
+    if (!value.empty() && value != "medium")
+    {
+        std::cerr << "Unknown priority '" << value << "', using medium" << std::endl;
+    }
+    return NpuPriority::MEDIUM;
+}
+
+const char* NpuScheduler::priorityName(NpuPriority priority)
+{
+    switch (priority)
+    {
+        case NpuPriority::HIGH:
+            return "high";
+        case NpuPriority::LOW:
+            return "low";
+        default:
+            return "medium";
+    }
+}
+
+}  // namespace rknn_cpp
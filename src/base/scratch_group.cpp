@@ -0,0 +1,206 @@
+#include "rknn_cpp/base/scratch_group.h"
+#include "rknn_cpp/base/memory_manager.h"
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+namespace rknn_cpp
+{
+
+std::shared_ptr<ScratchGroup> ScratchGroup::get(const std::string& name)
+{
+    static std::mutex registry_mutex;
+    static std::unordered_map<std::string, std::weak_ptr<ScratchGroup>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<ScratchGroup> group = registry[name].lock();
+    if (!group)
+    {
+        group.reset(new ScratchGroup(name));
+        registry[name] = group;
+    }
+    return group;
+}
+
+ScratchGroup::~ScratchGroup()
+{
+    // 所有成员离开时arena已释放；此处只剩没有可用ctx的异常情况
+    if (arena_ != nullptr)
+    {
+        std::cerr << "[SCRATCH] Group " << name_ << " destroyed with live arena" << std::endl;
+    }
+}
+
+size_t ScratchGroup::getArenaSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arena_size_;
+}
+
+bool ScratchGroup::isArenaOwner(rknn_context ctx) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arena_ != nullptr && arena_owner_ == ctx;
+}
+
+bool ScratchGroup::rebuildLocked(size_t size, size_t reserved)
+{
+    // 由第一个成员创建新arena并绑定到全部成员，成功后再释放旧arena
+    rknn_context owner = members_.front().ctx;
+    rknn_tensor_mem* arena = rknn_create_mem2(owner, size, RKNN_FLAG_MEMORY_FLAGS_DEFAULT);
+    if (arena == nullptr)
+    {
+        std::cerr << "[SCRATCH] rknn_create_mem2 failed for " << size << " bytes" << std::endl;
+        return false;
+    }
+    for (const auto& member : members_)
+    {
+        int ret = rknn_set_internal_mem(member.ctx, arena);
+        if (ret < 0)
+        {
+            std::cerr << "[SCRATCH] rknn_set_internal_mem failed! ret=" << ret << std::endl;
+            // 已改绑的成员恢复到旧arena
+            for (const auto& bound : members_)
+            {
+                if (bound.ctx == member.ctx)
+                {
+                    break;
+                }
+                if (arena_ != nullptr)
+                {
+                    rknn_set_internal_mem(bound.ctx, arena_);
+                }
+            }
+            rknn_destroy_mem(owner, arena);
+            return false;
+        }
+    }
+
+    if (arena_ != nullptr)
+    {
+        rknn_destroy_mem(arena_owner_, arena_);
+    }
+    if (retired_owner_ != 0)
+    {
+        rknn_destroy(retired_owner_);
+        retired_owner_ = 0;
+    }
+    // arena记入MemoryManager的共享部分，随重新分配按差值更新（扣除已预留的部分）
+    MemoryManager::instance().addSharedBytes(static_cast<int64_t>(size) - static_cast<int64_t>(arena_size_) -
+                                             static_cast<int64_t>(reserved));
+    arena_ = arena;
+    arena_owner_ = owner;
+    arena_size_ = size;
+    return true;
+}
+
+bool ScratchGroup::join(rknn_context ctx, size_t internal_size)
+{
+    // arena需要增长时先预留增量。预留可能淘汰空闲模型，被淘汰的模型会调用leave（可能就是本分组），
+    // 因此不能持有mutex_；释放锁期间arena可能变化，重新加锁后按当前大小检查预留是否足够
+    MemoryManager& memory_manager = MemoryManager::instance();
+    size_t reserved = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (internal_size > arena_size_ + reserved)
+    {
+        size_t need = internal_size - arena_size_ - reserved;
+        lock.unlock();
+        if (!memory_manager.reserveSharedBytes(need))
+        {
+            memory_manager.addSharedBytes(-static_cast<int64_t>(reserved));
+            std::cerr << "[SCRATCH] Memory budget too small to grow the arena of group " << name_ << " to "
+                      << (internal_size >> 10) << " KB" << std::endl;
+            return false;
+        }
+        reserved += need;
+        lock.lock();
+    }
+    members_.push_back({ctx, internal_size});
+
+    bool ok = true;
+    if (arena_ != nullptr && internal_size <= arena_size_)
+    {
+        // arena仍属于已离开的ctx时借此机会重新分配（同时绑定新成员），失败则继续共用原arena
+        bool rebuilt = retired_owner_ != 0 && rebuildLocked(arena_size_);
+        int ret = rebuilt ? RKNN_SUCC : rknn_set_internal_mem(ctx, arena_);
+        if (ret < 0)
+        {
+            std::cerr << "[SCRATCH] rknn_set_internal_mem failed! ret=" << ret << std::endl;
+            ok = false;
+        }
+    }
+    else if (rebuildLocked(internal_size, reserved))
+    {
+        reserved = 0;
+    }
+    else
+    {
+        ok = false;
+    }
+
+    // 未用到的预留（重新分配失败，或等待期间arena已被其他成员扩大）归还
+    if (reserved > 0)
+    {
+        memory_manager.addSharedBytes(-static_cast<int64_t>(reserved));
+    }
+    if (!ok)
+    {
+        members_.pop_back();
+        return false;
+    }
+
+    std::cout << "[SCRATCH] Joined group " << name_ << ": " << members_.size() << " models share "
+              << (arena_size_ >> 10) << " KB internal memory (this model needs " << (internal_size >> 10) << " KB)"
+              << std::endl;
+    return true;
+}
+
+bool ScratchGroup::leave(rknn_context ctx)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(members_.begin(), members_.end(), [ctx](const Member& m) { return m.ctx == ctx; });
+    if (it == members_.end())
+    {
+        return true;
+    }
+    members_.erase(it);
+
+    if (members_.empty())
+    {
+        if (arena_ != nullptr)
+        {
+            rknn_destroy_mem(arena_owner_, arena_);
+        }
+        if (retired_owner_ != 0)
+        {
+            rknn_destroy(retired_owner_);
+            retired_owner_ = 0;
+        }
+        MemoryManager::instance().addSharedBytes(-static_cast<int64_t>(arena_size_));
+        arena_ = nullptr;
+        arena_owner_ = 0;
+        arena_size_ = 0;
+        return true;
+    }
+
+    // arena由即将销毁的ctx创建（或仍属于之前保留的ctx）：按剩余成员中的最大需求重新分配
+    if (ctx == arena_owner_ || retired_owner_ != 0)
+    {
+        size_t size = 0;
+        for (const auto& member : members_)
+        {
+            size = std::max(size, member.internal_size);
+        }
+        if (!rebuildLocked(size) && ctx == arena_owner_)
+        {
+            // 剩余成员仍在使用该ctx创建的arena，保留ctx直到重新分配成功
+            std::cerr << "[SCRATCH] Failed to move arena of group " << name_
+                      << " off a released model, keeping its context alive" << std::endl;
+            retired_owner_ = ctx;
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace rknn_cpp
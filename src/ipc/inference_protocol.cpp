@@ -0,0 +1,117 @@
+#include "rknn_cpp/ipc/inference_protocol.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+const char* ipcStatusString(IpcStatus status)
+{
+    switch (status)
+    {
+        case IpcStatus::OK:
+            return "ok";
+        case IpcStatus::BAD_REQUEST:
+            return "bad request";
+        case IpcStatus::UNKNOWN_MODEL:
+            return "unknown model";
+        case IpcStatus::QUOTA_EXCEEDED:
+            return "quota exceeded";
+        case IpcStatus::INFERENCE_FAILED:
+            return "inference failed";
+        case IpcStatus::SHUTTING_DOWN:
+            return "server shutting down";
+        default:
+            return "unknown status";
+    }
+}
+
+bool ipcSend(int sock, const void* header, size_t header_size, const void* payload, size_t payload_size, int fd)
+{
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<void*>(header);
+    iov[0].iov_len = header_size;
+    iov[1].iov_base = const_cast<void*>(payload);
+    iov[1].iov_len = payload_size;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = payload_size > 0 ? 2 : 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    if (fd >= 0)
+    {
+        memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t sent;
+    do
+    {
+        sent = sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent == static_cast<ssize_t>(header_size + payload_size);
+}
+
+ssize_t ipcRecv(int sock, void* buffer, size_t capacity, int* fd)
+{
+    struct iovec iov;
+    iov.iov_base = buffer;
+    iov.iov_len = capacity;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do
+    {
+        received = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+
+    int received_fd = -1;
+    if (received >= 0)
+    {
+        for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            {
+                memcpy(&received_fd, CMSG_DATA(cmsg), sizeof(int));
+            }
+        }
+    }
+    // 截断的消息视为错误
+    if (received > 0 && (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0)
+    {
+        if (received_fd >= 0)
+        {
+            close(received_fd);
+        }
+        return -1;
+    }
+    if (fd != nullptr)
+    {
+        *fd = received_fd;
+    }
+    else if (received_fd >= 0)
+    {
+        close(received_fd);
+    }
+    return received;
+}
+
+}  // namespace rknn_cpp
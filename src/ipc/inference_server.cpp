@@ -0,0 +1,702 @@
+#include "rknn_cpp/ipc/inference_server.h"
+#include "rknn_cpp/utils/result_serializer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+// 类别名称块：每个条目u16长度 + 名称字节，顺序与二进制记录中的条目一致
+static void appendName(std::vector<char>& payload, const std::string& name)
+{
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+    const char* bytes = reinterpret_cast<const char*>(&length);
+    payload.insert(payload.end(), bytes, bytes + sizeof(length));
+    payload.insert(payload.end(), name.data(), name.data() + length);
+}
+
+// 结果数据须与任务类型对应，否则无法按任务类型附加类别名称
+static bool hasExpectedPayload(const InferenceResult& result)
+{
+    if (!result.result_data.has_value())
+    {
+        return true;
+    }
+    if (result.task_type == ModelTask::OBJECT_DETECTION)
+    {
+        return std::any_cast<DetectionResults>(&result.result_data) != nullptr;
+    }
+    if (result.task_type == ModelTask::CLASSIFICATION)
+    {
+        return std::any_cast<ClassificationResults>(&result.result_data) != nullptr;
+    }
+    return true;
+}
+
+static bool serializeResult(const InferenceResult& result, uint32_t request_id, std::vector<char>& payload)
+{
+    ResultRecordInfo info;
+    info.index = request_id;
+    payload.resize(binaryRecordSize(result, info));
+    if (serializeBinary(result, info, payload.data(), payload.size()) == 0)
+    {
+        return false;
+    }
+    const auto* detections = std::any_cast<DetectionResults>(&result.result_data);
+    const auto* classifications = std::any_cast<ClassificationResults>(&result.result_data);
+    if (result.task_type == ModelTask::OBJECT_DETECTION && detections != nullptr)
+    {
+        for (const auto& det : *detections)
+        {
+            appendName(payload, det.class_name);
+        }
+        // 级联分类的名称排在之后，顺序与记录中的级联分类条目一致
+        for (const auto& det : *detections)
+        {
+            for (const auto& cls : det.classifications)
+            {
+                appendName(payload, cls.class_name);
+            }
+        }
+    }
+    else if (result.task_type == ModelTask::CLASSIFICATION && classifications != nullptr)
+    {
+        for (const auto& cls : *classifications)
+        {
+            appendName(payload, cls.class_name);
+        }
+    }
+    return payload.size() + sizeof(IpcResponse) <= kIpcMaxMessage;
+}
+
+InferenceServer::InferenceServer(const InferenceServerConfig& config)
+    : config_(config), listen_fd_(-1), running_(false), rejected_quota_(0), bad_requests_(0)
+{
+    config_.max_batch = std::max(config_.max_batch, 1);
+}
+
+InferenceServer::~InferenceServer()
+{
+    stop();
+}
+
+bool InferenceServer::addModel(const std::string& name, std::vector<std::unique_ptr<IModel>> contexts)
+{
+    if (running_)
+    {
+        std::cerr << "Models must be added before the inference server starts" << std::endl;
+        return false;
+    }
+    if (name.empty() || name.size() >= kIpcModelNameSize || contexts.empty() || models_.count(name) > 0)
+    {
+        std::cerr << "Invalid or duplicate model name: " << name << std::endl;
+        return false;
+    }
+    for (const auto& context : contexts)
+    {
+        if (!context || !context->isInitialized())
+        {
+            std::cerr << "Model " << name << " has an uninitialized context" << std::endl;
+            return false;
+        }
+    }
+
+    auto entry = std::make_unique<ModelEntry>();
+    entry->name = name;
+    entry->contexts = std::move(contexts);
+    entry->stats.name = name;
+    entry->stats.contexts = entry->contexts.size();
+    models_[name] = std::move(entry);
+    return true;
+}
+
+bool InferenceServer::start()
+{
+    if (running_)
+    {
+        return true;
+    }
+    if (models_.empty())
+    {
+        std::cerr << "Inference server has no models" << std::endl;
+        return false;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (config_.socket_path.empty() || config_.socket_path.size() >= sizeof(addr.sun_path))
+    {
+        std::cerr << "Invalid socket path: " << config_.socket_path << std::endl;
+        return false;
+    }
+    strncpy(addr.sun_path, config_.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    listen_fd_ = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0)
+    {
+        std::cerr << "socket failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    unlink(config_.socket_path.c_str());
+    if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listen_fd_, 64) != 0)
+    {
+        std::cerr << "Failed to listen on " << config_.socket_path << ": " << strerror(errno) << std::endl;
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    for (auto& item : models_)
+    {
+        ModelEntry* entry = item.second.get();
+        for (auto& context : entry->contexts)
+        {
+            entry->workers.emplace_back(&InferenceServer::workerLoop, this, entry, context.get());
+        }
+    }
+    accept_thread_ = std::thread(&InferenceServer::acceptLoop, this);
+
+    std::cout << "Inference server listening on " << config_.socket_path << " (" << models_.size()
+              << " models, max_batch=" << config_.max_batch << ")" << std::endl;
+    return true;
+}
+
+void InferenceServer::stop()
+{
+    if (!running_.exchange(false))
+    {
+        return;
+    }
+
+    // 唤醒accept
+    shutdown(listen_fd_, SHUT_RDWR);
+    if (accept_thread_.joinable())
+    {
+        accept_thread_.join();
+    }
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    unlink(config_.socket_path.c_str());
+
+    // 唤醒工作线程，排队中的请求以SHUTTING_DOWN结束
+    for (auto& item : models_)
+    {
+        ModelEntry* entry = item.second.get();
+        {
+            std::lock_guard<std::mutex> lock(entry->mutex);
+        }
+        entry->cv.notify_all();
+    }
+
+    // 断开连接，等待连接线程退出
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto& connection : connections_)
+        {
+            shutdown(connection->fd, SHUT_RDWR);
+        }
+        for (auto& connection : connections_)
+        {
+            if (connection->thread.joinable())
+            {
+                connection->thread.join();
+            }
+            ::close(connection->fd);
+        }
+        connections_.clear();
+    }
+
+    for (auto& item : models_)
+    {
+        for (auto& worker : item.second->workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        item.second->workers.clear();
+    }
+}
+
+void InferenceServer::reapConnections()
+{
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (auto it = connections_.begin(); it != connections_.end();)
+    {
+        Connection* connection = it->get();
+        if (connection->finished)
+        {
+            connection->thread.join();
+            ::close(connection->fd);
+            it = connections_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void InferenceServer::acceptLoop()
+{
+    while (running_)
+    {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (!running_)
+            {
+                break;
+            }
+            if (errno != EINTR && errno != ECONNABORTED)
+            {
+                std::cerr << "accept failed: " << strerror(errno) << std::endl;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            continue;
+        }
+
+        struct ucred cred;
+        socklen_t cred_len = sizeof(cred);
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) != 0)
+        {
+            ::close(fd);
+            continue;
+        }
+
+        reapConnections();
+        {
+            std::lock_guard<std::mutex> lock(quota_mutex_);
+            ClientQuota& quota = quotas_[cred.pid];
+            if (quota.connections++ == 0)
+            {
+                quota.tokens = std::max(1.0, config_.max_rps);
+                quota.last_refill = std::chrono::steady_clock::now();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (!running_)
+        {
+            ::close(fd);
+            break;
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->pid = cred.pid;
+        connection->thread = std::thread(&InferenceServer::connectionLoop, this, connection.get());
+        connections_.push_back(std::move(connection));
+    }
+}
+
+void InferenceServer::connectionLoop(Connection* connection)
+{
+    uint8_t* shm = nullptr;
+    size_t shm_size = 0;
+    std::vector<char> payload;
+
+    while (running_)
+    {
+        IpcRequest request;
+        int fd = -1;
+        ssize_t received = ipcRecv(connection->fd, &request, sizeof(request), &fd);
+        if (received <= 0)
+        {
+            break;
+        }
+
+        IpcResponse response;
+        memset(&response, 0, sizeof(response));
+        response.magic = kIpcMagic;
+        response.version = kIpcVersion;
+        response.status = static_cast<uint16_t>(IpcStatus::BAD_REQUEST);
+        payload.clear();
+
+        bool valid = received == static_cast<ssize_t>(sizeof(request)) && request.magic == kIpcMagic &&
+                     request.version == kIpcVersion;
+        if (valid)
+        {
+            response.request_id = request.request_id;
+        }
+
+        // 客户端新建或扩容了共享内存：替换映射。要求已设置F_SEAL_SHRINK，避免客户端截断后服务端访问越界
+        if (valid && (request.flags & IPC_FLAG_NEW_SHM) != 0)
+        {
+            // 不支持封印的fd（如普通文件）F_GET_SEALS返回-1
+            struct stat st;
+            int seals = fd >= 0 ? fcntl(fd, F_GET_SEALS) : -1;
+            valid = seals >= 0 && (seals & F_SEAL_SHRINK) != 0 && request.shm_size > 0 &&
+                    request.shm_size <= config_.max_shm_bytes && fstat(fd, &st) == 0 &&
+                    static_cast<uint64_t>(st.st_size) >= request.shm_size;
+            if (shm != nullptr)
+            {
+                munmap(shm, shm_size);
+                shm = nullptr;
+                shm_size = 0;
+            }
+            if (valid)
+            {
+                void* addr = mmap(nullptr, request.shm_size, PROT_READ, MAP_SHARED, fd, 0);
+                if (addr != MAP_FAILED)
+                {
+                    shm = static_cast<uint8_t*>(addr);
+                    shm_size = request.shm_size;
+                }
+                else
+                {
+                    std::cerr << "mmap client buffer failed: " << strerror(errno) << std::endl;
+                    valid = false;
+                }
+            }
+        }
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+
+        if (valid)
+        {
+            handleRequest(connection, request, shm, shm_size, payload, response);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(quota_mutex_);
+            bad_requests_++;
+        }
+
+        response.payload_bytes = static_cast<uint32_t>(payload.size());
+        if (!ipcSend(connection->fd, &response, sizeof(response), payload.data(), payload.size()))
+        {
+            break;
+        }
+    }
+
+    if (shm != nullptr)
+    {
+        munmap(shm, shm_size);
+    }
+    {
+        std::lock_guard<std::mutex> lock(quota_mutex_);
+        auto it = quotas_.find(connection->pid);
+        if (it != quotas_.end() && --it->second.connections == 0)
+        {
+            quotas_.erase(it);
+        }
+    }
+    connection->finished = true;
+}
+
+void InferenceServer::handleRequest(Connection* connection, const IpcRequest& request, const uint8_t* shm,
+                                    size_t shm_size, std::vector<char>& payload, IpcResponse& response)
+{
+    std::string name(request.model_name, strnlen(request.model_name, kIpcModelNameSize));
+    auto it = models_.find(name);
+    if (it == models_.end())
+    {
+        response.status = static_cast<uint16_t>(IpcStatus::UNKNOWN_MODEL);
+        return;
+    }
+    ModelEntry* entry = it->second.get();
+
+    IpcOp op = static_cast<IpcOp>(request.op);
+    if (op == IpcOp::INFO)
+    {
+        IModel* model = entry->contexts.front().get();
+        ModelMemoryUsage usage = model->getMemoryUsage();
+        response.status = static_cast<uint16_t>(IpcStatus::OK);
+        response.task_type = static_cast<int32_t>(model->getTaskType());
+        response.model_width = model->getModelWidth();
+        response.model_height = model->getModelHeight();
+        response.model_channels = model->getModelChannels();
+        cv::Size max_input_size = model->getMaxInputSize();
+        response.max_input_width = max_input_size.width;
+        response.max_input_height = max_input_size.height;
+        response.weight_bytes = usage.weight_bytes;
+        response.internal_bytes = usage.internal_bytes;
+        response.io_bytes = usage.io_bytes;
+        response.host_bytes = usage.host_bytes;
+        response.sram_bytes = usage.sram_bytes;
+        std::string model_name = model->getModelName();
+        payload.assign(model_name.begin(), model_name.end());
+        return;
+    }
+
+    // 校验请求描述的数据位于共享内存内
+    Job job;
+    job.op = op;
+    if (op == IpcOp::PREDICT)
+    {
+        // 先校验尺寸、类型与step，再以uint64计算数据范围；step须为单通道元素大小的整数倍，否则cv::Mat构造时抛出异常
+        bool valid_type = request.type >= 0 && (request.type & ~CV_MAT_TYPE_MASK) == 0;
+        int elem_size = valid_type ? static_cast<int>(CV_ELEM_SIZE(request.type)) : 0;
+        int elem_size1 = valid_type ? static_cast<int>(CV_ELEM_SIZE1(request.type)) : 0;
+        bool valid = shm != nullptr && request.width > 0 && request.height > 0 && elem_size > 0 && elem_size1 > 0;
+        uint64_t row_bytes = valid ? static_cast<uint64_t>(request.width) * static_cast<uint64_t>(elem_size) : 0;
+        valid = valid && request.step >= row_bytes && request.step % elem_size1 == 0;
+        if (valid)
+        {
+            // height、step均已确认为正且不超过32位，乘积不会溢出uint64
+            uint64_t bytes = static_cast<uint64_t>(request.height - 1) * request.step + row_bytes;
+            valid = request.data_offset <= shm_size && bytes <= shm_size - request.data_offset;
+        }
+        if (!valid)
+        {
+            std::lock_guard<std::mutex> lock(quota_mutex_);
+            bad_requests_++;
+            return;
+        }
+        // 共享内存只读映射，预处理结果写入各自的缓冲区，不会改写输入
+        try
+        {
+            job.image = cv::Mat(request.height, request.width, request.type,
+                                const_cast<uint8_t*>(shm + request.data_offset), request.step);
+        }
+        catch (const cv::Exception& e)
+        {
+            std::cerr << "Invalid image in request: " << e.what() << std::endl;
+            std::lock_guard<std::mutex> lock(quota_mutex_);
+            bad_requests_++;
+            return;
+        }
+    }
+    else if (op == IpcOp::PREDICT_ENCODED)
+    {
+        if (shm == nullptr || request.data_bytes == 0 || request.data_offset > shm_size ||
+            request.data_bytes > shm_size - request.data_offset)
+        {
+            std::lock_guard<std::mutex> lock(quota_mutex_);
+            bad_requests_++;
+            return;
+        }
+        job.data = shm + request.data_offset;
+        job.size = request.data_bytes;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(quota_mutex_);
+        bad_requests_++;
+        return;
+    }
+
+    if (!acquireQuota(connection->pid))
+    {
+        response.status = static_cast<uint16_t>(IpcStatus::QUOTA_EXCEEDED);
+        return;
+    }
+
+    job.enqueue_time = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        if (!running_)
+        {
+            job.status = IpcStatus::SHUTTING_DOWN;
+            job.done = true;
+        }
+        else
+        {
+            entry->queue.push_back(&job);
+        }
+    }
+    entry->cv.notify_one();
+    {
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.cv.wait(lock, [&job] { return job.done; });
+    }
+    releaseQuota(connection->pid);
+
+    response.status = static_cast<uint16_t>(job.status);
+    response.queue_ms = job.queue_ms;
+    if (job.status == IpcStatus::OK || job.status == IpcStatus::INFERENCE_FAILED)
+    {
+        response.task_type = static_cast<int32_t>(job.result.task_type);
+        if (!hasExpectedPayload(job.result))
+        {
+            std::cerr << "Model " << name << " returned a result that does not match its task type" << std::endl;
+            response.status = static_cast<uint16_t>(IpcStatus::INFERENCE_FAILED);
+            payload.clear();
+        }
+        else if (!serializeResult(job.result, request.request_id, payload))
+        {
+            std::cerr << "Result of model " << name << " exceeds the message size limit" << std::endl;
+            response.status = static_cast<uint16_t>(IpcStatus::INFERENCE_FAILED);
+            payload.clear();
+        }
+    }
+}
+
+bool InferenceServer::acquireQuota(pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(quota_mutex_);
+    ClientQuota& quota = quotas_[pid];
+    if (config_.max_inflight > 0 && quota.inflight >= config_.max_inflight)
+    {
+        rejected_quota_++;
+        return false;
+    }
+    if (config_.max_rps > 0.0)
+    {
+        // 令牌桶：按经过时间补充，桶容量为1秒的请求数（至少1个，max_rps小于1时仍可放行）
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - quota.last_refill).count();
+        quota.tokens = std::min(std::max(1.0, config_.max_rps), quota.tokens + elapsed * config_.max_rps);
+        quota.last_refill = now;
+        if (quota.tokens < 1.0)
+        {
+            rejected_quota_++;
+            return false;
+        }
+        quota.tokens -= 1.0;
+    }
+    quota.inflight++;
+    return true;
+}
+
+void InferenceServer::releaseQuota(pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(quota_mutex_);
+    auto it = quotas_.find(pid);
+    if (it != quotas_.end())
+    {
+        it->second.inflight--;
+    }
+}
+
+void InferenceServer::workerLoop(ModelEntry* entry, IModel* model)
+{
+    std::vector<Job*> batch;
+    batch.reserve(config_.max_batch);
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(entry->mutex);
+            entry->cv.wait(lock, [&] { return !running_ || !entry->queue.empty(); });
+            if (!running_)
+            {
+                while (!entry->queue.empty())
+                {
+                    Job* job = entry->queue.front();
+                    entry->queue.pop_front();
+                    std::lock_guard<std::mutex> job_lock(job->mutex);
+                    job->status = IpcStatus::SHUTTING_DOWN;
+                    job->done = true;
+                    job->cv.notify_one();
+                }
+                break;
+            }
+
+            // 凑批：队列不足max_batch时短暂等待后续请求
+            if (config_.batch_timeout_us > 0 && entry->queue.size() < static_cast<size_t>(config_.max_batch))
+            {
+                entry->cv.wait_for(lock, std::chrono::microseconds(config_.batch_timeout_us), [&] {
+                    return !running_ || entry->queue.size() >= static_cast<size_t>(config_.max_batch);
+                });
+            }
+
+            size_t count = std::min(entry->queue.size(), static_cast<size_t>(config_.max_batch));
+            if (count == 0)
+            {
+                continue;
+            }
+            batch.assign(entry->queue.begin(), entry->queue.begin() + count);
+            entry->queue.erase(entry->queue.begin(), entry->queue.begin() + count);
+            entry->stats.batches++;
+            entry->stats.requests += count;
+        }
+
+        // 同一上下文上连续执行，输入输出缓冲区与预处理状态保持热
+        size_t failed = 0;
+        double queue_ms = 0.0;
+        for (Job* job : batch)
+        {
+            job->queue_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() -
+                                                                     job->enqueue_time)
+                                .count();
+            queue_ms += job->queue_ms;
+
+            // 客户端数据导致的OpenCV异常不能终止服务进程，按推理失败返回
+            InferenceResult result;
+            try
+            {
+                result = job->op == IpcOp::PREDICT ? model->predict(job->image)
+                                                   : model->predictEncoded(job->data, job->size);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Inference on model " << entry->name << " threw: " << e.what() << std::endl;
+                result.task_type = model->getTaskType();
+                result.is_success = false;
+                result.inference_time = 0.0f;
+                result.total_time = 0.0f;
+            }
+            if (!result.is_success)
+            {
+                failed++;
+            }
+
+            std::lock_guard<std::mutex> job_lock(job->mutex);
+            job->status = result.is_success ? IpcStatus::OK : IpcStatus::INFERENCE_FAILED;
+            job->result = std::move(result);
+            job->done = true;
+            job->cv.notify_one();
+        }
+        batch.clear();
+
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        entry->stats.failed += failed;
+        entry->stats.queue_ms += queue_ms;
+    }
+}
+
+InferenceServerStats InferenceServer::getStats() const
+{
+    InferenceServerStats stats;
+    for (const auto& item : models_)
+    {
+        std::lock_guard<std::mutex> lock(item.second->mutex);
+        stats.models.push_back(item.second->stats);
+    }
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (const auto& connection : connections_)
+        {
+            if (!connection->finished)
+            {
+                stats.connections++;
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(quota_mutex_);
+    stats.rejected_quota = rejected_quota_;
+    stats.bad_requests = bad_requests_;
+    return stats;
+}
+
+void InferenceServer::printSummary() const
+{
+    InferenceServerStats stats = getStats();
+    std::cout << "\n=== Inference Server Summary ===" << std::endl;
+    for (const auto& model : stats.models)
+    {
+        std::cout << "  " << model.name << ": contexts=" << model.contexts << " requests=" << model.requests
+                  << " failed=" << model.failed << " avg_batch=" << std::fixed << std::setprecision(2)
+                  << model.avgBatch() << " avg_queue=" << model.avgQueueMs() << "ms" << std::endl;
+    }
+    std::cout << "  Connections: " << stats.connections << ", rejected by quota: " << stats.rejected_quota
+              << ", bad requests: " << stats.bad_requests << std::endl;
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,551 @@
+#include "rknn_cpp/ipc/remote_model.h"
+#include "rknn_cpp/utils/image_decode.h"
+#include "rknn_cpp/utils/result_serializer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+static const size_t kMinBufferSize = 1 << 20;
+
+RemoteModel::RemoteModel(const std::string& socket_path, const std::string& model_name)
+    : socket_path_(socket_path),
+      model_name_(model_name),
+      timeout_ms_(0),
+      sock_(-1),
+      shm_fd_(-1),
+      shm_(nullptr),
+      shm_size_(0),
+      shm_sent_(false),
+      next_request_id_(0),
+      initialized_(false),
+      task_type_(ModelTask::UNKNOWN),
+      model_width_(0),
+      model_height_(0),
+      model_channels_(0)
+{
+}
+
+RemoteModel::~RemoteModel()
+{
+    release();
+}
+
+bool RemoteModel::initialize(const ModelConfig& config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    disconnect();
+    initialized_ = false;
+
+    auto it = config.find("socket_path");
+    if (it != config.end())
+    {
+        socket_path_ = it->second;
+    }
+    it = config.find("model_name");
+    if (it != config.end())
+    {
+        model_name_ = it->second;
+    }
+    it = config.find("timeout_ms");
+    timeout_ms_ = it != config.end() ? std::atoi(it->second.c_str()) : 0;
+
+    if (model_name_.empty() || model_name_.size() >= kIpcModelNameSize)
+    {
+        std::cerr << "RemoteModel needs a valid model_name" << std::endl;
+        return false;
+    }
+    if (!connectServer())
+    {
+        return false;
+    }
+
+    IpcRequest request;
+    memset(&request, 0, sizeof(request));
+    request.op = static_cast<uint16_t>(IpcOp::INFO);
+    IpcResponse response;
+    const char* payload = nullptr;
+    size_t payload_size = 0;
+    if (!call(request, response, payload, payload_size))
+    {
+        return false;
+    }
+    if (response.status != static_cast<uint16_t>(IpcStatus::OK))
+    {
+        std::cerr << "Remote model " << model_name_ << ": "
+                  << ipcStatusString(static_cast<IpcStatus>(response.status)) << std::endl;
+        disconnect();
+        return false;
+    }
+
+    task_type_ = static_cast<ModelTask>(response.task_type);
+    model_width_ = response.model_width;
+    model_height_ = response.model_height;
+    model_channels_ = response.model_channels;
+    max_input_size_ = cv::Size(response.max_input_width, response.max_input_height);
+    memory_usage_.weight_bytes = response.weight_bytes;
+    memory_usage_.internal_bytes = response.internal_bytes;
+    memory_usage_.io_bytes = response.io_bytes;
+    memory_usage_.host_bytes = response.host_bytes;
+    memory_usage_.sram_bytes = response.sram_bytes;
+    remote_name_.assign(payload, payload_size);
+    initialized_ = true;
+
+    std::cout << "Connected to remote model " << model_name_ << " (" << remote_name_ << ", " << model_width_ << "x"
+              << model_height_ << "x" << model_channels_ << ") at " << socket_path_ << std::endl;
+    return true;
+}
+
+std::future<bool> RemoteModel::initializeAsync(const ModelConfig& config)
+{
+    return std::async(std::launch::async, [this, config] { return initialize(config); });
+}
+
+bool RemoteModel::connectServer()
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path_.empty() || socket_path_.size() >= sizeof(addr.sun_path))
+    {
+        std::cerr << "Invalid socket path: " << socket_path_ << std::endl;
+        return false;
+    }
+    strncpy(addr.sun_path, socket_path_.c_str(), sizeof(addr.sun_path) - 1);
+
+    sock_ = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (sock_ < 0)
+    {
+        std::cerr << "socket failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    if (connect(sock_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        std::cerr << "Failed to connect to inference server " << socket_path_ << ": " << strerror(errno)
+                  << std::endl;
+        ::close(sock_);
+        sock_ = -1;
+        return false;
+    }
+    if (timeout_ms_ > 0)
+    {
+        struct timeval tv;
+        tv.tv_sec = timeout_ms_ / 1000;
+        tv.tv_usec = (timeout_ms_ % 1000) * 1000;
+        setsockopt(sock_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+    recv_buffer_.resize(kIpcMaxMessage);
+    shm_sent_ = false;
+    return true;
+}
+
+void RemoteModel::disconnect()
+{
+    if (sock_ >= 0)
+    {
+        ::close(sock_);
+        sock_ = -1;
+    }
+    shm_sent_ = false;
+}
+
+bool RemoteModel::ensureBuffer(size_t bytes)
+{
+    if (shm_ != nullptr && bytes <= shm_size_)
+    {
+        return true;
+    }
+
+    size_t capacity = std::max(kMinBufferSize, shm_size_);
+    while (capacity < bytes)
+    {
+        capacity *= 2;
+    }
+
+    // 封印F_SEAL_SHRINK：服务端据此确认映射范围内的访问不会因截断而SIGBUS
+    int fd = memfd_create("rknn_remote_model", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        std::cerr << "memfd_create failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    void* addr = MAP_FAILED;
+    if (ftruncate(fd, capacity) == 0 && fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK) == 0)
+    {
+        addr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (addr == MAP_FAILED)
+    {
+        std::cerr << "Failed to allocate " << capacity << " bytes of shared memory: " << strerror(errno)
+                  << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    if (shm_ != nullptr)
+    {
+        munmap(shm_, shm_size_);
+        ::close(shm_fd_);
+    }
+    shm_fd_ = fd;
+    shm_ = static_cast<uint8_t*>(addr);
+    shm_size_ = capacity;
+    shm_sent_ = false;
+    return true;
+}
+
+bool RemoteModel::inBuffer(const void* data, size_t bytes) const
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    return shm_ != nullptr && ptr >= shm_ && bytes <= shm_size_ && static_cast<size_t>(ptr - shm_) <= shm_size_ - bytes;
+}
+
+cv::Mat RemoteModel::getInputBuffer(int width, int height, int type)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = static_cast<size_t>(width) * height * CV_ELEM_SIZE(type);
+    if (width <= 0 || height <= 0 || !ensureBuffer(bytes))
+    {
+        return cv::Mat();
+    }
+    return cv::Mat(height, width, type, shm_);
+}
+
+bool RemoteModel::call(IpcRequest& request, IpcResponse& response, const char*& payload, size_t& payload_size)
+{
+    if (sock_ < 0 && !connectServer())
+    {
+        return false;
+    }
+
+    request.magic = kIpcMagic;
+    request.version = kIpcVersion;
+    request.request_id = ++next_request_id_;
+    strncpy(request.model_name, model_name_.c_str(), kIpcModelNameSize - 1);
+
+    int fd = -1;
+    if (shm_ != nullptr && !shm_sent_)
+    {
+        request.flags |= IPC_FLAG_NEW_SHM;
+        request.shm_size = shm_size_;
+        fd = shm_fd_;
+    }
+    if (!ipcSend(sock_, &request, sizeof(request), nullptr, 0, fd))
+    {
+        std::cerr << "Failed to send request to inference server: " << strerror(errno) << std::endl;
+        disconnect();
+        return false;
+    }
+    if (fd >= 0)
+    {
+        shm_sent_ = true;
+    }
+
+    ssize_t received = ipcRecv(sock_, recv_buffer_.data(), recv_buffer_.size(), nullptr);
+    if (received < static_cast<ssize_t>(sizeof(IpcResponse)))
+    {
+        // 超时或连接断开：丢弃连接，避免之后读到过期的响应
+        std::cerr << "No response from inference server" << (received < 0 ? std::string(": ") + strerror(errno) : "")
+                  << std::endl;
+        disconnect();
+        return false;
+    }
+    memcpy(&response, recv_buffer_.data(), sizeof(response));
+    if (response.magic != kIpcMagic || response.request_id != request.request_id ||
+        response.payload_bytes > static_cast<size_t>(received) - sizeof(IpcResponse))
+    {
+        std::cerr << "Malformed response from inference server" << std::endl;
+        disconnect();
+        return false;
+    }
+    payload = recv_buffer_.data() + sizeof(IpcResponse);
+    payload_size = response.payload_bytes;
+    return true;
+}
+
+InferenceResult RemoteModel::callPredict(IpcRequest& request, std::chrono::steady_clock::time_point start)
+{
+    IpcResponse response;
+    const char* payload = nullptr;
+    size_t payload_size = 0;
+    if (!call(request, response, payload, payload_size))
+    {
+        return createFailedResult(start);
+    }
+
+    IpcStatus status = static_cast<IpcStatus>(response.status);
+    BinaryResultRecord record;
+    size_t consumed = 0;
+    if (payload_size == 0 || !decodeBinaryRecord(payload, payload_size, record, consumed))
+    {
+        std::cerr << "Remote inference failed: " << ipcStatusString(status) << std::endl;
+        return createFailedResult(start);
+    }
+
+    // 记录之后为类别名称块
+    const char* names = payload + consumed;
+    size_t names_size = payload_size - consumed;
+    auto nextName = [&](std::string& name) {
+        uint16_t length = 0;
+        if (names_size < sizeof(length))
+        {
+            return;
+        }
+        memcpy(&length, names, sizeof(length));
+        length = static_cast<uint16_t>(std::min<size_t>(length, names_size - sizeof(length)));
+        name.assign(names + sizeof(length), length);
+        names += sizeof(length) + length;
+        names_size -= sizeof(length) + length;
+    };
+
+    InferenceResult result;
+    result.task_type = task_type_;
+    if (task_type_ == ModelTask::OBJECT_DETECTION)
+    {
+        for (auto& det : record.detections)
+        {
+            nextName(det.class_name);
+        }
+        for (auto& det : record.detections)
+        {
+            for (auto& cls : det.classifications)
+            {
+                nextName(cls.class_name);
+            }
+        }
+        result.result_data = std::move(record.detections);
+    }
+    else if (task_type_ == ModelTask::CLASSIFICATION)
+    {
+        for (auto& cls : record.classifications)
+        {
+            nextName(cls.class_name);
+        }
+        result.result_data = std::move(record.classifications);
+    }
+    result.is_success = status == IpcStatus::OK && record.success;
+    result.inference_time = record.inference_ms;
+    result.total_time =
+        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+InferenceResult RemoteModel::createFailedResult(std::chrono::steady_clock::time_point start) const
+{
+    // 与本地模型的createEmptyResult一致：失败结果也带有对应任务类型的空结果，getDetections等不会抛出
+    InferenceResult result;
+    result.task_type = task_type_;
+    switch (result.task_type)
+    {
+        case ModelTask::CLASSIFICATION:
+            result.result_data = ClassificationResults{};
+            break;
+        default:
+            result.result_data = DetectionResults{};
+            break;
+    }
+    result.is_success = false;
+    result.inference_time = 0.0f;
+    result.total_time =
+        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+InferenceResult RemoteModel::predictLocked(const cv::Mat& image, std::chrono::steady_clock::time_point start)
+{
+    if (!initialized_ || image.empty())
+    {
+        std::cerr << (initialized_ ? "Empty input image" : "RemoteModel not initialized") << std::endl;
+        return createFailedResult(start);
+    }
+
+    IpcRequest request;
+    memset(&request, 0, sizeof(request));
+    request.op = static_cast<uint16_t>(IpcOp::PREDICT);
+    request.width = image.cols;
+    request.height = image.rows;
+    request.type = image.type();
+
+    size_t row_bytes = image.cols * image.elemSize();
+    size_t bytes = (image.rows - 1) * image.step + row_bytes;
+    if (inBuffer(image.data, bytes))
+    {
+        // 已位于共享内存中（getInputBuffer及其ROI视图）：只传偏移
+        request.data_offset = image.data - shm_;
+        request.step = static_cast<uint32_t>(image.step);
+    }
+    else
+    {
+        if (!ensureBuffer(row_bytes * image.rows))
+        {
+            return createFailedResult(start);
+        }
+        cv::Mat dst(image.rows, image.cols, image.type(), shm_, row_bytes);
+        image.copyTo(dst);
+        request.step = static_cast<uint32_t>(row_bytes);
+    }
+    return callPredict(request, start);
+}
+
+InferenceResult RemoteModel::predict(const cv::Mat& image)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return predictLocked(image, start);
+}
+
+InferenceResult RemoteModel::predict(const cv::Mat& image, const cv::Rect& roi)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    cv::Rect region = roi & cv::Rect(0, 0, image.cols, image.rows);
+    if (region.empty())
+    {
+        std::cerr << "Invalid ROI: (" << roi.x << "," << roi.y << "," << roi.width << "," << roi.height << ")"
+                  << std::endl;
+        return createFailedResult(start);
+    }
+
+    // 只发送ROI区域，检测框平移回整帧坐标
+    InferenceResult result = predictLocked(image(region), start);
+    if (result.is_success && result.task_type == ModelTask::OBJECT_DETECTION && result.result_data.has_value())
+    {
+        for (auto& det : std::any_cast<DetectionResults&>(result.result_data))
+        {
+            det.x = static_cast<uint16_t>(det.x + region.x);
+            det.y = static_cast<uint16_t>(det.y + region.y);
+        }
+    }
+    return result;
+}
+
+InferenceResult RemoteModel::predictTensors(const std::vector<InputTensor>& inputs)
+{
+    (void)inputs;
+    std::cerr << "predictTensors is not supported by RemoteModel" << std::endl;
+    return createFailedResult(std::chrono::steady_clock::now());
+}
+
+InferenceResult RemoteModel::predictEncodedLocked(const uint8_t* data, size_t size,
+                                                  std::chrono::steady_clock::time_point start)
+{
+    if (!initialized_ || data == nullptr || size == 0)
+    {
+        std::cerr << (initialized_ ? "Empty encoded image" : "RemoteModel not initialized") << std::endl;
+        return createFailedResult(start);
+    }
+
+    IpcRequest request;
+    memset(&request, 0, sizeof(request));
+    request.op = static_cast<uint16_t>(IpcOp::PREDICT_ENCODED);
+    request.data_bytes = size;
+    if (inBuffer(data, size))
+    {
+        request.data_offset = data - shm_;
+    }
+    else
+    {
+        if (!ensureBuffer(size))
+        {
+            return createFailedResult(start);
+        }
+        memcpy(shm_, data, size);
+    }
+    // 服务端解码，结果坐标为原图坐标
+    return callPredict(request, start);
+}
+
+InferenceResult RemoteModel::predictEncoded(const uint8_t* data, size_t size)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return predictEncodedLocked(data, size, start);
+}
+
+InferenceResult RemoteModel::predictFile(const std::string& path)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> data;
+    if (!readFileBytes(path, data))
+    {
+        return createFailedResult(start);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return predictEncodedLocked(data.data(), data.size(), start);
+}
+
+void RemoteModel::release()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    disconnect();
+    if (shm_ != nullptr)
+    {
+        munmap(shm_, shm_size_);
+        ::close(shm_fd_);
+        shm_ = nullptr;
+        shm_fd_ = -1;
+        shm_size_ = 0;
+    }
+    initialized_ = false;
+}
+
+std::vector<LayerProfile> RemoteModel::getLayerProfile() const
+{
+    return {};
+}
+
+void RemoteModel::resetLayerProfile() {}
+
+ModelMemoryUsage RemoteModel::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_usage_;
+}
+
+ModelTask RemoteModel::getTaskType() const
+{
+    return task_type_;
+}
+
+std::string RemoteModel::getModelName() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return remote_name_.empty() ? model_name_ : remote_name_;
+}
+
+bool RemoteModel::isInitialized() const
+{
+    return initialized_;
+}
+
+int RemoteModel::getModelWidth() const
+{
+    return model_width_;
+}
+
+int RemoteModel::getModelHeight() const
+{
+    return model_height_;
+}
+
+int RemoteModel::getModelChannels() const
+{
+    return model_channels_;
+}
+
+cv::Size RemoteModel::getMaxInputSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_input_size_;
+}
+
+}  // namespace rknn_cpp
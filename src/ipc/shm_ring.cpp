@@ -0,0 +1,471 @@
+#include "rknn_cpp/ipc/shm_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+static const uint32_t kShmMagic = 0x52524B53;  // "SKRR"
+static const uint32_t kShmVersion = 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory ring needs lock-free 64-bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared-memory ring needs lock-free 32-bit atomics");
+
+// 槽位持续处于写入状态超过该时长视为发布者在写入中途退出
+static const int64_t kTornTimeoutUs = 100000;
+// 没有新帧时检查发布者重建的最小间隔
+static const int64_t kRestartCheckIntervalUs = 200000;
+
+static int64_t steadyMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static size_t alignUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+static size_t headerAreaSize()
+{
+    return alignUp(sizeof(ShmRingHeader), 64);
+}
+
+static std::string shmName(const std::string& name)
+{
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+// ===== ShmResultPublisher =====
+
+ShmResultPublisher::~ShmResultPublisher()
+{
+    close();
+}
+
+bool ShmResultPublisher::create(const ShmRingConfig& config)
+{
+    close();
+    if (config.name.empty() || config.slot_count == 0)
+    {
+        std::cerr << "Shared-memory ring needs a name and at least one slot" << std::endl;
+        return false;
+    }
+
+    size_t result_bytes = alignUp(config.max_result_bytes, 8);
+    size_t slot_size = alignUp(sizeof(ShmSlotHeader) + result_bytes + config.max_frame_bytes, 64);
+    size_t total_size = headerAreaSize() + slot_size * config.slot_count;
+    if (slot_size > UINT32_MAX)
+    {
+        std::cerr << "Shared-memory ring slot too large: " << slot_size << " bytes" << std::endl;
+        return false;
+    }
+
+    // 重建时先删除旧名称，已打开旧段的读者不受影响
+    name_ = shmName(config.name);
+    shm_unlink(name_.c_str());
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        std::cerr << "shm_open " << name_ << " failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(total_size)) != 0)
+    {
+        std::cerr << "ftruncate shared memory failed: " << strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(name_.c_str());
+        return false;
+    }
+    void* addr = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+    {
+        std::cerr << "mmap shared memory failed: " << strerror(errno) << std::endl;
+        shm_unlink(name_.c_str());
+        return false;
+    }
+
+    // ftruncate后内容为0，即全部槽位seqlock为0、无数据
+    base_ = static_cast<char*>(addr);
+    mapped_size_ = total_size;
+    header_ = new (base_) ShmRingHeader;
+    header_->version = kShmVersion;
+    header_->slot_count = config.slot_count;
+    header_->slot_size = static_cast<uint32_t>(slot_size);
+    header_->max_result_bytes = static_cast<uint32_t>(result_bytes);
+    header_->max_frame_bytes = static_cast<uint32_t>(config.max_frame_bytes);
+    header_->latest_seq.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < config.slot_count; i++)
+    {
+        new (base_ + headerAreaSize() + i * slot_size) ShmSlotHeader;
+    }
+    header_->magic.store(kShmMagic, std::memory_order_release);
+    next_seq_ = 1;
+    frame_warned_ = false;
+
+    std::cout << "[SHM] Publishing on " << name_ << ": " << config.slot_count << " slots x " << (slot_size >> 10)
+              << " KB" << std::endl;
+    return true;
+}
+
+void ShmResultPublisher::close()
+{
+    if (base_ == nullptr)
+    {
+        return;
+    }
+    munmap(base_, mapped_size_);
+    shm_unlink(name_.c_str());
+    base_ = nullptr;
+    header_ = nullptr;
+    mapped_size_ = 0;
+}
+
+uint64_t ShmResultPublisher::publish(const InferenceResult& result, const cv::Mat* frame, int64_t timestamp_us)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr)
+    {
+        return 0;
+    }
+
+    uint64_t seq = next_seq_;
+    ResultRecordInfo info;
+    info.index = seq;
+    info.timestamp_us = timestamp_us;
+    size_t result_bytes = binaryRecordSize(result, info);
+    if (result_bytes > header_->max_result_bytes)
+    {
+        std::cerr << "[SHM] Result record too large (" << result_bytes << " bytes), frame " << seq << " not published"
+                  << std::endl;
+        return 0;
+    }
+
+    size_t frame_bytes = 0;
+    if (frame != nullptr && !frame->empty())
+    {
+        frame_bytes = frame->total() * frame->elemSize();
+        if (frame_bytes > header_->max_frame_bytes)
+        {
+            if (!frame_warned_)
+            {
+                std::cerr << "[SHM] Frame (" << frame_bytes
+                          << " bytes) exceeds max_frame_bytes, publishing results only" << std::endl;
+                frame_warned_ = true;
+            }
+            frame_bytes = 0;
+        }
+    }
+
+    char* slot = base_ + headerAreaSize() + ((seq - 1) % header_->slot_count) * header_->slot_size;
+    auto* slot_header = reinterpret_cast<ShmSlotHeader*>(slot);
+    char* result_data = slot + sizeof(ShmSlotHeader);
+    char* frame_data = result_data + header_->max_result_bytes;
+
+    // seqlock：计数变为奇数后再写数据，写完后变为偶数
+    uint64_t lock_count = slot_header->lock.load(std::memory_order_relaxed);
+    slot_header->lock.store(lock_count + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot_header->seq = seq;
+    slot_header->timestamp_us = timestamp_us;
+    slot_header->result_bytes = static_cast<uint32_t>(serializeBinary(result, info, result_data, result_bytes));
+    slot_header->frame_bytes = static_cast<uint32_t>(frame_bytes);
+    slot_header->frame_width = frame_bytes > 0 ? frame->cols : 0;
+    slot_header->frame_height = frame_bytes > 0 ? frame->rows : 0;
+    slot_header->frame_type = frame_bytes > 0 ? frame->type() : 0;
+    if (frame_bytes > 0)
+    {
+        size_t row_bytes = frame->cols * frame->elemSize();
+        for (int y = 0; y < frame->rows; y++)
+        {
+            memcpy(frame_data + y * row_bytes, frame->ptr(y), row_bytes);
+        }
+    }
+
+    slot_header->lock.store(lock_count + 2, std::memory_order_release);
+    header_->latest_seq.store(seq, std::memory_order_release);
+    next_seq_++;
+    return seq;
+}
+
+// ===== ShmResultSubscriber =====
+
+ShmResultSubscriber::~ShmResultSubscriber()
+{
+    close();
+}
+
+bool ShmResultSubscriber::open(const std::string& name)
+{
+    close();
+    std::string shm_name = shmName(name);
+    name_ = shm_name;
+    int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < headerAreaSize())
+    {
+        ::close(fd);
+        return false;
+    }
+    device_ = st.st_dev;
+    inode_ = st.st_ino;
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return false;
+    }
+
+    base_ = static_cast<const char*>(addr);
+    mapped_size_ = static_cast<size_t>(st.st_size);
+    header_ = reinterpret_cast<const ShmRingHeader*>(base_);
+    if (header_->magic.load(std::memory_order_acquire) != kShmMagic || header_->version != kShmVersion ||
+        headerAreaSize() + static_cast<size_t>(header_->slot_size) * header_->slot_count > mapped_size_)
+    {
+        close();
+        return false;
+    }
+    last_seq_ = 0;
+    last_restart_check_us_ = steadyMicros();
+    result_buffer_.resize(header_->max_result_bytes);
+    return true;
+}
+
+bool ShmResultSubscriber::reopenIfRestarted()
+{
+    if (name_.empty())
+    {
+        return false;
+    }
+    int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return false;  // 发布者已退出且删除了名称，保留旧映射
+    }
+    struct stat st;
+    bool same = fstat(fd, &st) != 0 || (st.st_dev == device_ && st.st_ino == inode_);
+    ::close(fd);
+    if (same && header_ != nullptr)
+    {
+        return false;
+    }
+
+    // 旧段不会再有新帧；新段可能尚未初始化完成，此时open失败，之后再次检查时重试
+    std::string name = name_;
+    if (!open(name))
+    {
+        return false;
+    }
+    std::cout << "[SHM] Publisher on " << name_ << " restarted, reopened shared memory" << std::endl;
+    return true;
+}
+
+bool ShmResultSubscriber::checkRestart()
+{
+    int64_t now = steadyMicros();
+    if (now - last_restart_check_us_ < kRestartCheckIntervalUs)
+    {
+        return false;
+    }
+    last_restart_check_us_ = now;
+    return reopenIfRestarted();
+}
+
+void ShmResultSubscriber::close()
+{
+    if (base_ == nullptr)
+    {
+        return;
+    }
+    munmap(const_cast<char*>(base_), mapped_size_);
+    base_ = nullptr;
+    header_ = nullptr;
+    mapped_size_ = 0;
+}
+
+uint64_t ShmResultSubscriber::getLatestSeq() const
+{
+    return header_ != nullptr ? header_->latest_seq.load(std::memory_order_acquire) : 0;
+}
+
+ShmResultSubscriber::ReadStatus ShmResultSubscriber::read(uint64_t seq, ShmFrame& frame)
+{
+    uint64_t latest = getLatestSeq();
+    if (seq == 0 || seq > latest)
+    {
+        return ReadStatus::NOT_READY;
+    }
+    if (latest - seq >= header_->slot_count)
+    {
+        return ReadStatus::OVERWRITTEN;
+    }
+
+    const char* slot = base_ + headerAreaSize() + ((seq - 1) % header_->slot_count) * header_->slot_size;
+    const auto* slot_header = reinterpret_cast<const ShmSlotHeader*>(slot);
+    const char* result_data = slot + sizeof(ShmSlotHeader);
+    const char* frame_data = result_data + header_->max_result_bytes;
+
+    int64_t deadline_us = 0;
+    for (int attempt = 0;; attempt++)
+    {
+        // 发布者写入中途退出时计数停在奇数，重试有时限，避免读者一直空转
+        if (attempt > 0)
+        {
+            int64_t now = steadyMicros();
+            if (deadline_us == 0)
+            {
+                deadline_us = now + kTornTimeoutUs;
+            }
+            else if (now > deadline_us)
+            {
+                return ReadStatus::TORN;
+            }
+        }
+
+        uint64_t lock_before = slot_header->lock.load(std::memory_order_acquire);
+        if (lock_before & 1)
+        {
+            std::this_thread::yield();  // 发布者正在写该槽位
+            continue;
+        }
+
+        // 复制期间数据可能被改写，先检查范围保证访问安全，一致性由前后seqlock计数判断
+        uint64_t slot_seq = slot_header->seq;
+        int64_t timestamp_us = slot_header->timestamp_us;
+        size_t result_bytes = slot_header->result_bytes;
+        size_t frame_bytes = slot_header->frame_bytes;
+        int width = slot_header->frame_width;
+        int height = slot_header->frame_height;
+        int type = slot_header->frame_type;
+        bool valid = result_bytes <= header_->max_result_bytes && frame_bytes <= header_->max_frame_bytes;
+        if (valid && frame_bytes > 0)
+        {
+            valid = width > 0 && height > 0 && type >= 0 && type < 512 &&
+                    static_cast<size_t>(width) * height * CV_ELEM_SIZE(type) == frame_bytes;
+        }
+        if (valid && slot_seq == seq)
+        {
+            memcpy(result_buffer_.data(), result_data, result_bytes);
+            if (frame_bytes > 0)
+            {
+                frame.image.create(height, width, type);
+                memcpy(frame.image.data, frame_data, frame_bytes);
+            }
+            else
+            {
+                frame.image.release();
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot_header->lock.load(std::memory_order_relaxed) != lock_before)
+        {
+            continue;  // 读取过程中被改写，重试
+        }
+        if (slot_seq != seq)
+        {
+            return slot_seq > seq ? ReadStatus::OVERWRITTEN : ReadStatus::NOT_READY;
+        }
+        if (!valid)
+        {
+            return ReadStatus::NOT_READY;
+        }
+
+        size_t consumed = 0;
+        if (!decodeBinaryRecord(result_buffer_.data(), result_bytes, frame.result, consumed))
+        {
+            return ReadStatus::NOT_READY;
+        }
+        frame.seq = seq;
+        frame.timestamp_us = timestamp_us;
+        return ReadStatus::OK;
+    }
+}
+
+bool ShmResultSubscriber::readLatest(ShmFrame& frame)
+{
+    if (header_ == nullptr || getLatestSeq() == last_seq_)
+    {
+        checkRestart();  // 没有新帧时检查发布者是否已重建
+    }
+    // 读取期间最新帧可能又被覆盖，重新取最新序号
+    while (header_ != nullptr)
+    {
+        uint64_t latest = getLatestSeq();
+        if (latest == 0)
+        {
+            return false;
+        }
+        ReadStatus status = read(latest, frame);
+        if (status == ReadStatus::OK)
+        {
+            last_seq_ = latest;
+            return true;
+        }
+        if (status != ReadStatus::OVERWRITTEN)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool ShmResultSubscriber::next(ShmFrame& frame, uint64_t* dropped)
+{
+    if (dropped != nullptr)
+    {
+        *dropped = 0;
+    }
+    if (header_ == nullptr)
+    {
+        return checkRestart() && readLatest(frame);
+    }
+    // 首次调用从最新帧开始，不回放历史
+    if (last_seq_ == 0)
+    {
+        return readLatest(frame);
+    }
+
+    uint64_t seq = last_seq_ + 1;
+    while (true)
+    {
+        ReadStatus status = read(seq, frame);
+        if (status == ReadStatus::OK)
+        {
+            last_seq_ = seq;
+            return true;
+        }
+        if (status == ReadStatus::NOT_READY || status == ReadStatus::TORN)
+        {
+            return checkRestart() && readLatest(frame);
+        }
+        // 落后超过环形缓冲区长度：跳到仍可读取的最旧帧
+        uint64_t latest = getLatestSeq();
+        uint64_t oldest = latest >= header_->slot_count ? latest - header_->slot_count + 1 : 1;
+        uint64_t target = std::max(oldest + 1, seq + 1);  // 留出一帧余量，避免再次被覆盖
+        if (dropped != nullptr)
+        {
+            *dropped += target - seq;
+        }
+        seq = target;
+    }
+}
+
+}  // namespace rknn_cpp
@@ -94,21 +94,14 @@ InferenceResult CustomModel::postprocessOutputs(rknn_output* outputs, int output
         return createClassificationResult({});
     }
 
-    // 获取输出数据
-
-    float* output_data = static_cast<float*>(outputs[0].buf);
-    if (output_data == nullptr)
-    {
-        std::cerr << "Output buffer is null" << std::endl;
-        return createClassificationResult({});
-    }
-
+    // 获取输出数据，按输出类型（int8/uint8/fp16/fp32）转换为float
     int num_classes = output_attrs[0].n_elems;
     std::cout << "[INFO] Processing " << num_classes << " classification classes" << std::endl;
     std::vector<float> float_output(num_classes);
-    for (int i = 0; i < num_classes; i++)
+    if (!readOutputAsFloat(outputs[0], 0, 0, num_classes, 1, float_output.data()))
     {
-        float_output[i] = output_data[i];
+        std::cerr << "Failed to read output buffer" << std::endl;
+        return createClassificationResult({});
     }
     // 应用softmax
     applySoftmax(float_output.data(), num_classes);
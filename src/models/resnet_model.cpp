@@ -58,23 +58,22 @@ bool ResNetModel::setupModel(const ModelConfig& config)
 
 bool ResNetModel::preprocessImage(const cv::Mat& src_img, cv::Mat& dst_img)
 {
-    cv::Mat input_img{};
-    if (src_img.channels() == 1 && getModelChannels() == 3)
-    {
-        cv::cvtColor(src_img, input_img, cv::COLOR_GRAY2RGB);
-    }
-    else
-    {
-        cv::cvtColor(src_img, input_img, cv::COLOR_BGR2RGB);
-    }
     std::cout << "\n[PREPROCESS] ResNet image preprocessing (cv::Mat)" << std::endl;
 
-    // 使用基类提供的标准预处理方法
-    if (!standardPreprocess(input_img, dst_img))
+    // 先缩放到模型尺寸再转换颜色：颜色转换只处理模型输入大小的像素，ROI视图也无需先拷贝
+    if (!standardPreprocess(src_img, resized_img_))
     {
         std::cerr << "Failed to preprocess image" << std::endl;
         return false;
     }
+    if (resized_img_.channels() == 1 && getModelChannels() == 3)
+    {
+        cv::cvtColor(resized_img_, dst_img, cv::COLOR_GRAY2RGB);
+    }
+    else
+    {
+        cv::cvtColor(resized_img_, dst_img, cv::COLOR_BGR2RGB);
+    }
     return true;
 }
 
@@ -95,21 +94,14 @@ InferenceResult ResNetModel::postprocessOutputs(rknn_output* outputs, int output
         return createClassificationResult({});
     }
 
-    // 获取输出数据
-
-    float* output_data = static_cast<float*>(outputs[0].buf);
-    if (output_data == nullptr)
-    {
-        std::cerr << "Output buffer is null" << std::endl;
-        return createClassificationResult({});
-    }
-
+    // 获取输出数据，按输出类型（int8/uint8/fp16/fp32）转换为float
     int num_classes = output_attrs[0].n_elems;
     std::cout << "[INFO] Processing " << num_classes << " classification classes" << std::endl;
     std::vector<float> float_output(num_classes);
-    for (int i = 0; i < num_classes; i++)
+    if (!readOutputAsFloat(outputs[0], 0, 0, num_classes, 1, float_output.data()))
     {
-        float_output[i] = output_data[i];
+        std::cerr << "Failed to read output buffer" << std::endl;
+        return createClassificationResult({});
     }
     // 应用softmax
     applySoftmax(float_output.data(), num_classes);
@@ -1,4 +1,5 @@
 #include "rknn_cpp/models/yolov3_model.h"
+#include "rknn_cpp/utils/box_utils.h"
 #include "opencv2/opencv.hpp"
 #include <iostream>
 #include <algorithm>
@@ -7,13 +8,11 @@
 #include <sstream>
 #include <cmath>
 #include <chrono>
-#include <set>
-#include <numeric>
 #include <iomanip>
 
 namespace rknn_cpp
 {
-static const int PROP_BOX_SIZE = 6;  // 4(bbox) + 1(conf) + 80(classes)
+static const int PROP_BOX_SIZE = 6;  // 4(bbox) + 1(conf) + OBJ_CLASS_NUM(classes)
 static const int OBJ_CLASS_NUM = 1;  // COCO数据集类别数
 
 Yolov3Model::Yolov3Model() : class_names_loaded_(false) {}
@@ -121,6 +120,14 @@ bool Yolov3Model::preprocessImage(const cv::Mat& src_img, cv::Mat& dst_img)
     return true;
 }
 
+void Yolov3Model::resetPreprocessState()
+{
+    // 张量输入即模型输入空间，坐标无需letterbox还原
+    letterbox_params_.scale = 1.0f;
+    letterbox_params_.x_pad = 0;
+    letterbox_params_.y_pad = 0;
+}
+
 InferenceResult Yolov3Model::postprocessOutputs(rknn_output* outputs, int output_count)
 {
     std::cout << "\n[POSTPROCESS] YOLOv3 detection analysis" << std::endl;
@@ -139,6 +146,17 @@ InferenceResult Yolov3Model::postprocessOutputs(rknn_output* outputs, int output
     std::vector<YoloLayer> yolo_layers = {{40, 40, 16, {3.59968, 3.59968, 4.5352, 3.80864, 4.55072, 4.54688}},
                                           {20, 20, 32, {5.34368, 4.57824, 4.81248, 5.6016, 6.67584, 5.71488}}};
     const auto& output_attrs = getOutputAttrs();
+
+    // 网格尺寸以当前输出属性为准，动态shape模型每帧的网格可能不同
+    for (int i = 0; i < output_count && i < static_cast<int>(yolo_layers.size()); ++i)
+    {
+        const auto& attr = output_attrs[i];
+        if (attr.n_dims == 4)
+        {
+            yolo_layers[i].grid_h = static_cast<int>(attr.dims[2]);
+            yolo_layers[i].grid_w = static_cast<int>(attr.dims[3]);
+        }
+    }
     std::vector<float> boxes;
     std::vector<float> objProbs;
     std::vector<int> classId;
@@ -154,32 +172,23 @@ InferenceResult Yolov3Model::postprocessOutputs(rknn_output* outputs, int output
         std::cout << "[LAYER " << i << "] Processing output: " << layer.grid_h << " x " << layer.grid_w
                   << " (stride=" << layer.stride << ")" << std::endl;
 
-        // 验证输出维度
-        if (attr.dims[2] != static_cast<uint32_t>(layer.grid_h) || attr.dims[3] != static_cast<uint32_t>(layer.grid_w))
+        // 验证输出网格与输入尺寸、步长一致
+        if (layer.grid_h * layer.stride != getModelHeight() || layer.grid_w * layer.stride != getModelWidth())
         {
-            std::cerr << "Warning: Output dimensions mismatch for layer " << i << ", expected " << layer.grid_h << "x"
-                      << layer.grid_w << ", got " << attr.dims[2] << "x" << attr.dims[3] << std::endl;
+            std::cerr << "Warning: Output grid mismatch for layer " << i << ", input " << getModelWidth() << "x"
+                      << getModelHeight() << " with stride " << layer.stride << ", got " << layer.grid_w << "x"
+                      << layer.grid_h << std::endl;
         }
 
-        int valid_count = 0;
-
         if (isQuantized())
         {
             std::cout << "[QUANT] zp=" << attr.zp << ", scale=" << std::fixed << std::setprecision(6) << attr.scale
                       << std::endl;
-            std::cout << "[MODE] Processing quantized model" << std::endl;
-            // 处理量化模型
-            valid_count = processYoloLayer(outputs[i].buf, true, layer, boxes, objProbs, classId, this->conf_threshold_,
-                                           attr.zp, attr.scale);
-        }
-        else
-        {
-            // 处理浮点模型
-            std::cout << "Process float model" << std::endl;
-            valid_count =
-                processYoloLayer(outputs[i].buf, false, layer, boxes, objProbs, classId, this->conf_threshold_);
         }
 
+        // 量化与浮点输出统一按需转换，只读取通过置信度筛选的位置
+        int valid_count = processYoloLayer(outputs[i], i, layer, boxes, objProbs, classId, this->conf_threshold_);
+
         total_valid_boxes += valid_count;
     }
 
@@ -284,158 +293,100 @@ float Yolov3Model::sigmoid(float x) const
 {
     return 1.0f / (1.0f + expf(-x));
 }
-float Yolov3Model::deqnt_affine_to_f32(int8_t qnt, int32_t zp, float scale) const
-{
-    return scale * ((float)qnt - (float)zp);
-}
-
-int Yolov3Model::processYoloLayer(void* input, bool is_quantized, const YoloLayer& layer, std::vector<float>& boxes,
-                                  std::vector<float>& objProbs, std::vector<int>& classId, float threshold, int32_t zp,
-                                  float scale) const
+int Yolov3Model::processYoloLayer(const rknn_output& output, int output_index, const YoloLayer& layer,
+                                  std::vector<float>& boxes, std::vector<float>& objProbs, std::vector<int>& classId,
+                                  float threshold) const
 {
+    RKNN_TRACE_SCOPE("Yolov3::processYoloLayer");
     auto start_time = std::chrono::high_resolution_clock::now();
 
     int validCount = 0;
     int grid_len = layer.grid_h * layer.grid_w;
 
-    if (is_quantized)
+    // sigmoid单调，置信度阈值换算到logit域后可直接比较原始输出
+    float conf_logit = -INFINITY;
+    if (threshold >= 1.0f)
     {
-        int8_t* data = static_cast<int8_t*>(input);
-        for (int a = 0; a < 3; a++)
-        {
-            for (int i = 0; i < layer.grid_h; i++)
-            {
-                for (int j = 0; j < layer.grid_w; j++)
-                {
-                    int conf_idx = (PROP_BOX_SIZE * a + 4) * grid_len + i * layer.grid_w + j;
-                    float conf_input = deqnt_affine_to_f32(data[conf_idx], zp, scale);
-                    float box_confidence = sigmoid(conf_input);
-
-                    if (box_confidence >= threshold)
-                    {
-                        int offset = (PROP_BOX_SIZE * a) * grid_len + i * layer.grid_w + j;
-
-                        float tx = deqnt_affine_to_f32(data[offset], zp, scale);
-                        float ty = deqnt_affine_to_f32(data[offset + grid_len], zp, scale);
-                        float tw = deqnt_affine_to_f32(data[offset + 2 * grid_len], zp, scale);
-                        float th = deqnt_affine_to_f32(data[offset + 3 * grid_len], zp, scale);
-
-                        float sig_tx = sigmoid(tx);
-                        float sig_ty = sigmoid(ty);
-                        float sig_tw = sigmoid(tw);
-                        float sig_th = sigmoid(th);
-
-                        float box_x = sig_tx * 2.0f - 0.5f;
-                        float box_y = sig_ty * 2.0f - 0.5f;
-                        float box_w = powf(sig_tw * 2.0f, 2);
-                        float box_h = powf(sig_th * 2.0f, 2);
-
-                        box_x = (box_x + j) * static_cast<float>(layer.stride);
-                        box_y = (box_y + i) * static_cast<float>(layer.stride);
-                        box_w *= (layer.anchors[a * 2]);
-                        box_h *= (layer.anchors[a * 2 + 1]);
-
-                        box_x -= (box_w / 2.0f);
-                        box_y -= (box_h / 2.0f);
-
-                        float class_input = deqnt_affine_to_f32(data[offset + 5 * grid_len], zp, scale);
-                        float maxClassProbs = sigmoid(class_input);
-                        int maxClassId = 0;
-
-                        for (int k = 1; k < OBJ_CLASS_NUM; ++k)
-                        {
-                            float cls_input = deqnt_affine_to_f32(data[offset + (5 + k) * grid_len], zp, scale);
-                            float prob = sigmoid(cls_input);
-                            if (prob > maxClassProbs)
-                            {
-                                maxClassId = k;
-                                maxClassProbs = prob;
-                            }
-                        }
-
-                        float final_conf = maxClassProbs * box_confidence;
-                        if (final_conf > threshold)
-                        {
-                            objProbs.push_back(final_conf);
-                            classId.push_back(maxClassId);
-                            validCount++;
-
-                            boxes.push_back(box_x);
-                            boxes.push_back(box_y);
-                            boxes.push_back(box_w);
-                            boxes.push_back(box_h);
-                        }
-                    }
-                }
-            }
-        }
+        conf_logit = INFINITY;
     }
-    else
+    else if (threshold > 0.0f)
+    {
+        conf_logit = logf(threshold / (1.0f - threshold));
+    }
+
+    std::vector<float> conf_plane(grid_len);
+    float cell[PROP_BOX_SIZE];
+
+    for (int a = 0; a < 3; a++)
     {
-        float* data = static_cast<float*>(input);
-        for (int a = 0; a < 3; a++)
+        // 连续转换当前anchor的置信度平面
+        if (!readOutputAsFloat(output, output_index, (PROP_BOX_SIZE * a + 4) * grid_len, grid_len, 1,
+                               conf_plane.data()))
+        {
+            return validCount;
+        }
+
+        for (int i = 0; i < layer.grid_h; i++)
         {
-            for (int i = 0; i < layer.grid_h; i++)
+            for (int j = 0; j < layer.grid_w; j++)
             {
-                for (int j = 0; j < layer.grid_w; j++)
+                float conf_input = conf_plane[i * layer.grid_w + j];
+                if (conf_input < conf_logit)
                 {
-                    int conf_idx = (PROP_BOX_SIZE * a + 4) * grid_len + i * layer.grid_w + j;
-                    float box_confidence = sigmoid(data[conf_idx]);
+                    continue;
+                }
+                float box_confidence = sigmoid(conf_input);
 
-                    if (box_confidence >= threshold)
+                // 跨步读取该位置的 tx, ty, tw, th, conf, classes
+                int offset = (PROP_BOX_SIZE * a) * grid_len + i * layer.grid_w + j;
+                if (!readOutputAsFloat(output, output_index, offset, PROP_BOX_SIZE, grid_len, cell))
+                {
+                    return validCount;
+                }
+
+                float sig_tx = sigmoid(cell[0]);
+                float sig_ty = sigmoid(cell[1]);
+                float sig_tw = sigmoid(cell[2]);
+                float sig_th = sigmoid(cell[3]);
+
+                float box_x = sig_tx * 2.0f - 0.5f;
+                float box_y = sig_ty * 2.0f - 0.5f;
+                float box_w = powf(sig_tw * 2.0f, 2);
+                float box_h = powf(sig_th * 2.0f, 2);
+
+                box_x = (box_x + j) * static_cast<float>(layer.stride);
+                box_y = (box_y + i) * static_cast<float>(layer.stride);
+                box_w *= (layer.anchors[a * 2]);
+                box_h *= (layer.anchors[a * 2 + 1]);
+
+                box_x -= (box_w / 2.0f);
+                box_y -= (box_h / 2.0f);
+
+                float maxClassProbs = sigmoid(cell[5]);
+                int maxClassId = 0;
+
+                for (int k = 1; k < OBJ_CLASS_NUM; ++k)
+                {
+                    float prob = sigmoid(cell[5 + k]);
+                    if (prob > maxClassProbs)
                     {
-                        int offset = (PROP_BOX_SIZE * a) * grid_len + i * layer.grid_w + j;
-
-                        float tx = data[offset];
-                        float ty = data[offset + grid_len];
-                        float tw = data[offset + 2 * grid_len];
-                        float th = data[offset + 3 * grid_len];
-
-                        float sig_tx = sigmoid(tx);
-                        float sig_ty = sigmoid(ty);
-                        float sig_tw = sigmoid(tw);
-                        float sig_th = sigmoid(th);
-
-                        float box_x = sig_tx * 2.0f - 0.5f;
-                        float box_y = sig_ty * 2.0f - 0.5f;
-                        float box_w = powf(sig_tw * 2.0f, 2);
-                        float box_h = powf(sig_th * 2.0f, 2);
-
-                        box_x = (box_x + j) * static_cast<float>(layer.stride);
-                        box_y = (box_y + i) * static_cast<float>(layer.stride);
-                        box_w *= (layer.anchors[a * 2]);
-                        box_h *= (layer.anchors[a * 2 + 1]);
-
-                        box_x -= (box_w / 2.0f);
-                        box_y -= (box_h / 2.0f);
-
-                        float maxClassProbs = sigmoid(data[offset + 5 * grid_len]);
-                        int maxClassId = 0;
-
-                        for (int k = 1; k < OBJ_CLASS_NUM; ++k)
-                        {
-                            float prob = sigmoid(data[offset + (5 + k) * grid_len]);
-                            if (prob > maxClassProbs)
-                            {
-                                maxClassId = k;
-                                maxClassProbs = prob;
-                            }
-                        }
-
-                        float final_conf = maxClassProbs * box_confidence;
-                        if (final_conf > threshold)
-                        {
-                            objProbs.push_back(final_conf);
-                            classId.push_back(maxClassId);
-                            validCount++;
-
-                            boxes.push_back(box_x);
-                            boxes.push_back(box_y);
-                            boxes.push_back(box_w);
-                            boxes.push_back(box_h);
-                        }
+                        maxClassId = k;
+                        maxClassProbs = prob;
                     }
                 }
+
+                float final_conf = maxClassProbs * box_confidence;
+                if (final_conf > threshold)
+                {
+                    objProbs.push_back(final_conf);
+                    classId.push_back(maxClassId);
+                    validCount++;
+
+                    boxes.push_back(box_x);
+                    boxes.push_back(box_y);
+                    boxes.push_back(box_w);
+                    boxes.push_back(box_h);
+                }
             }
         }
     }
@@ -449,91 +400,10 @@ int Yolov3Model::processYoloLayer(void* input, bool is_quantized, const YoloLaye
     return validCount;
 }
 
-float Yolov3Model::calculateIoU(float xmin0, float ymin0, float xmax0, float ymax0, float xmin1, float ymin1,
-                                float xmax1, float ymax1) const
-{
-    // 计算交集区域
-    float inter_xmin = std::max(xmin0, xmin1);
-    float inter_ymin = std::max(ymin0, ymin1);
-    float inter_xmax = std::min(xmax0, xmax1);
-    float inter_ymax = std::min(ymax0, ymax1);
-
-    // 检查是否有交集
-    if (inter_xmin >= inter_xmax || inter_ymin >= inter_ymax)
-    {
-        return 0.0f;
-    }
-
-    // 计算交集面积
-    float inter_area = (inter_xmax - inter_xmin) * (inter_ymax - inter_ymin);
-
-    // 计算并集面积
-    float area0 = (xmax0 - xmin0) * (ymax0 - ymin0);
-    float area1 = (xmax1 - xmin1) * (ymax1 - ymin1);
-    float union_area = area0 + area1 - inter_area;
-
-    // 避免除零
-    if (union_area <= 0.0f)
-    {
-        return 0.0f;
-    }
-
-    return inter_area / union_area;
-}
-
-int Yolov3Model::nmsForClass(const std::vector<float>& boxes, const std::vector<int>& classIds, std::vector<int>& order,
-                             int filterId, float threshold) const
-{
-    int validCount = static_cast<int>(order.size());
-
-    for (int i = 0; i < validCount; ++i)
-    {
-        int n = order[i];
-        // 跳过已被抑制的框或不是目标类别的框
-        if (n == -1 || classIds[n] != filterId)
-        {
-            continue;
-        }
-
-        // 获取当前框的坐标 (x, y, w, h)
-        float xmin0 = boxes[n * 4 + 0];
-        float ymin0 = boxes[n * 4 + 1];
-        float xmax0 = boxes[n * 4 + 0] + boxes[n * 4 + 2];  // x + w
-        float ymax0 = boxes[n * 4 + 1] + boxes[n * 4 + 3];  // y + h
-
-        // 与后续所有框比较
-        for (int j = i + 1; j < validCount; ++j)
-        {
-            int m = order[j];
-            // 跳过已被抑制的框或不是目标类别的框
-            if (m == -1 || classIds[m] != filterId)
-            {
-                continue;
-            }
-
-            // 获取比较框的坐标 (x, y, w, h)
-            float xmin1 = boxes[m * 4 + 0];
-            float ymin1 = boxes[m * 4 + 1];
-            float xmax1 = boxes[m * 4 + 0] + boxes[m * 4 + 2];  // x + w
-            float ymax1 = boxes[m * 4 + 1] + boxes[m * 4 + 3];  // y + h
-
-            // 计算IoU
-            float iou = calculateIoU(xmin0, ymin0, xmax0, ymax0, xmin1, ymin1, xmax1, ymax1);
-
-            // 如果IoU超过阈值，抑制置信度较低的框
-            if (iou > threshold)
-            {
-                order[j] = -1;  // 标记为被抑制
-            }
-        }
-    }
-
-    return 0;
-}
-
 std::vector<int> Yolov3Model::applyNMS(const std::vector<float>& boxes, const std::vector<float>& scores,
                                        const std::vector<int>& classIds, float nms_threshold) const
 {
+    RKNN_TRACE_SCOPE("Yolov3::applyNMS");
     int validCount = static_cast<int>(boxes.size() / 4);
 
     if (validCount == 0)
@@ -545,31 +415,8 @@ std::vector<int> Yolov3Model::applyNMS(const std::vector<float>& boxes, const st
     std::cout << "      Threshold: " << std::fixed << std::setprecision(3) << nms_threshold << std::endl;
     std::cout << "      Input boxes: " << validCount << std::endl;
 
-    // 创建索引数组并按置信度排序
-    std::vector<int> order(validCount);
-    std::iota(order.begin(), order.end(), 0);  // 填充0,1,2...
-
-    // 按置信度降序排序
-    std::sort(order.begin(), order.end(), [&scores](int a, int b) { return scores[a] > scores[b]; });
-
-    // 获取所有唯一的类别ID
-    std::set<int> unique_classes(classIds.begin(), classIds.end());
-
-    // 对每个类别分别进行NMS
-    for (int class_id : unique_classes)
-    {
-        nmsForClass(boxes, classIds, order, class_id, nms_threshold);
-    }
-
-    // 收集未被抑制的检测框索引
-    std::vector<int> keep_indices;
-    for (int i = 0; i < validCount; ++i)
-    {
-        if (order[i] != -1)  // 未被抑制
-        {
-            keep_indices.push_back(order[i]);
-        }
-    }
+    // 按类别NMS，与分块推理结果合并共用同一实现
+    std::vector<int> keep_indices = nmsBoxes(boxes, scores, classIds, nms_threshold);
 
     std::cout << "NMS completed: " << keep_indices.size() << " boxes kept out of " << validCount << std::endl;
 
@@ -595,6 +442,12 @@ void Yolov3Model::convertLetterboxToOriginal(DetectionResults& detections, int o
     std::cout << "            Scale: " << letterbox_params_.scale << ", Pads: (" << letterbox_params_.x_pad << ", "
               << letterbox_params_.y_pad << ")" << std::endl;
 
+    const cv::Point roi_offset = getRoiOffset();
+    if (roi_offset.x != 0 || roi_offset.y != 0)
+    {
+        std::cout << "            ROI offset: (" << roi_offset.x << ", " << roi_offset.y << ")" << std::endl;
+    }
+
     for (auto& detection : detections)
     {
         // 保存原始坐标用于调试
@@ -620,6 +473,10 @@ void Yolov3Model::convertLetterboxToOriginal(DetectionResults& detections, int o
         detection.width = std::min(detection.width, static_cast<uint16_t>(orig_width - detection.x));
         detection.height = std::min(detection.height, static_cast<uint16_t>(orig_height - detection.y));
 
+        // 4. ROI推理时平移回整帧坐标
+        detection.x = static_cast<uint16_t>(detection.x + roi_offset.x);
+        detection.y = static_cast<uint16_t>(detection.y + roi_offset.y);
+
         std::cout << "            [" << detection.class_name << "] "
                   << "(" << orig_x << "," << orig_y << "," << orig_w << "," << orig_h << ") -> "
                   << "(" << detection.x << "," << detection.y << "," << detection.width << "," << detection.height
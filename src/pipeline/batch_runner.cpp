@@ -0,0 +1,381 @@
+#include "rknn_cpp/pipeline/batch_runner.h"
+#include "rknn_cpp/utils/image_decode.h"
+#include "rknn_cpp/utils/tracer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace rknn_cpp
+{
+
+namespace fs = std::filesystem;
+
+static bool isImageFile(const fs::path& path)
+{
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp";
+}
+
+// FNV-1a，用于确认断点对应同一份输入列表
+static uint64_t hashInputs(const std::vector<std::string>& inputs)
+{
+    uint64_t hash = 1469598103934665603ull;
+    for (const auto& input : inputs)
+    {
+        for (unsigned char c : input)
+        {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        hash = (hash ^ '\n') * 1099511628211ull;
+    }
+    return hash;
+}
+
+BatchRunner::BatchRunner(const std::vector<IModel*>& models, const BatchRunnerConfig& config)
+    : models_(models), config_(config), output_(config.format)
+{
+    config_.decode_threads = std::max(1, config_.decode_threads);
+    config_.prefetch = std::max(1, config_.prefetch);
+    config_.checkpoint_interval = std::max(1, config_.checkpoint_interval);
+    if (config_.checkpoint_path.empty() && !config_.output_path.empty())
+    {
+        config_.checkpoint_path = config_.output_path + ".ckpt";
+    }
+}
+
+std::vector<std::string> BatchRunner::listInputs(const std::string& path)
+{
+    std::vector<std::string> inputs;
+    std::error_code ec;
+    if (fs::is_directory(path, ec))
+    {
+        for (fs::recursive_directory_iterator it(path, ec), end; it != end && !ec; it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && isImageFile(it->path()))
+            {
+                inputs.push_back(it->path().string());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    std::ifstream manifest(path);
+    if (!manifest.is_open())
+    {
+        std::cerr << "Cannot open input directory or manifest: " << path << std::endl;
+        return inputs;
+    }
+    fs::path base = fs::path(path).parent_path();
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+        {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        fs::path entry(line);
+        inputs.push_back(entry.is_absolute() ? line : (base / entry).string());
+    }
+    return inputs;
+}
+
+bool BatchRunner::openOutput(uint64_t inputs_hash)
+{
+    // 读取断点：next_index output_bytes inputs_hash
+    Checkpoint checkpoint;
+    bool resumed = false;
+    if (config_.resume)
+    {
+        std::ifstream file(config_.checkpoint_path);
+        if (file >> checkpoint.next_index >> checkpoint.output_bytes >> checkpoint.inputs_hash)
+        {
+            std::error_code ec;
+            uintmax_t output_size = fs::file_size(config_.output_path, ec);
+            if (checkpoint.inputs_hash != inputs_hash || checkpoint.next_index > inputs_.size())
+            {
+                std::cout << "[BATCH] Checkpoint does not match the input list, starting over" << std::endl;
+            }
+            else if (ec || output_size < checkpoint.output_bytes)
+            {
+                std::cout << "[BATCH] Output shorter than checkpoint, starting over" << std::endl;
+            }
+            else
+            {
+                // 截掉断点之后写出的结果，这些条目会重新处理
+                fs::resize_file(config_.output_path, checkpoint.output_bytes, ec);
+                resumed = !ec;
+            }
+        }
+    }
+
+    if (!output_.open(config_.output_path, resumed))
+    {
+        return false;
+    }
+    next_write_ = resumed ? checkpoint.next_index : 0;
+    if (resumed)
+    {
+        std::cout << "[BATCH] Resuming from checkpoint: " << next_write_ << "/" << inputs_.size() << " done"
+                  << std::endl;
+    }
+    return true;
+}
+
+bool BatchRunner::writeCheckpoint(size_t next_index)
+{
+    if (!output_.flush())
+    {
+        return false;
+    }
+    uint64_t output_bytes = output_.getFileOffset();
+
+    // 先写临时文件再rename，中断时不会留下半个断点
+    std::string tmp_path = config_.checkpoint_path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        file << next_index << " " << output_bytes << " " << inputs_hash_ << "\n";
+        if (!file)
+        {
+            std::cerr << "Failed to write checkpoint: " << tmp_path << std::endl;
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp_path, config_.checkpoint_path, ec);
+    return !ec;
+}
+
+bool BatchRunner::run(const std::vector<std::string>& inputs)
+{
+    if (models_.empty() || config_.output_path.empty())
+    {
+        std::cerr << "BatchRunner needs at least one model and an output path" << std::endl;
+        return false;
+    }
+
+    inputs_ = inputs;
+    inputs_hash_ = hashInputs(inputs_);
+    if (!openOutput(inputs_hash_))
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = BatchStats();
+        stats_.total = inputs_.size();
+        stats_.skipped = next_write_;
+        next_decode_ = next_write_;
+        end_ = inputs_.size();
+        window_ = static_cast<size_t>(config_.prefetch) + models_.size();
+        decoded_.clear();
+        results_.clear();
+        decoding_ = 0;
+        stop_ = false;
+        active_workers_ = config_.decode_threads + static_cast<int>(models_.size());
+    }
+
+    std::cout << "[BATCH] " << inputs_.size() - next_write_ << " images to process with " << models_.size()
+              << " contexts and " << config_.decode_threads << " decode threads" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < config_.decode_threads; i++)
+    {
+        workers.emplace_back(&BatchRunner::decodeLoop, this);
+    }
+    for (IModel* model : models_)
+    {
+        workers.emplace_back(&BatchRunner::inferLoop, this, model);
+    }
+
+    // 写出线程：按输入顺序写结果并定期更新断点
+    size_t since_checkpoint = 0;
+    while (true)
+    {
+        Completed completed;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() {
+                return next_write_ >= end_ || results_.count(next_write_) > 0 || active_workers_ == 0;
+            });
+            auto it = results_.find(next_write_);
+            if (it == results_.end())
+            {
+                break;  // 全部完成，或已停止且后续结果不会再产生
+            }
+            completed = std::move(it->second);
+            results_.erase(it);
+        }
+
+        ResultRecordInfo info;
+        info.index = next_write_;
+        info.source = inputs_[next_write_];
+        info.error = completed.decode_failed ? "decode failed" : "";
+        output_.write(completed.result, info);
+
+        size_t processed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            next_write_++;
+            processed = ++stats_.processed;
+            stats_.elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        cond_.notify_all();
+
+        if (++since_checkpoint >= static_cast<size_t>(config_.checkpoint_interval))
+        {
+            writeCheckpoint(next_write_);
+            since_checkpoint = 0;
+        }
+        if (config_.progress_interval > 0 && processed % config_.progress_interval == 0)
+        {
+            BatchStats stats = getStats();
+            std::cout << "[BATCH] " << stats.skipped + stats.processed << "/" << stats.total << " done, "
+                      << std::fixed << std::setprecision(1) << stats.imagesPerSec() << " images/s"
+                      << std::defaultfloat << std::endl;
+        }
+    }
+
+    stop();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    writeCheckpoint(next_write_);
+    output_.close();
+
+    BatchStats stats = getStats();
+    std::cout << "[BATCH] Processed " << stats.processed << " images (" << stats.failed << " failed, "
+              << stats.skipped << " skipped) in " << std::fixed << std::setprecision(1) << stats.elapsed_s << " s, "
+              << stats.imagesPerSec() << " images/s" << std::defaultfloat << std::endl;
+    return stats.skipped + stats.processed == stats.total;
+}
+
+void BatchRunner::decodeLoop()
+{
+    // 动态shape模型按最大shape解码，与IModel::predictEncoded一致
+    const cv::Size min_size = models_[0]->getMaxInputSize();
+    while (true)
+    {
+        size_t index;
+        {
+            // 预取窗口：解码进度最多领先写出进度window_条，限制内存占用
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock,
+                       [this]() { return stop_ || next_decode_ >= end_ || next_decode_ < next_write_ + window_; });
+            if (stop_ || next_decode_ >= end_)
+            {
+                break;
+            }
+            index = next_decode_++;
+            decoding_++;
+        }
+
+        Decoded decoded;
+        {
+            RKNN_TRACE_SCOPE("decode");
+            auto start = std::chrono::steady_clock::now();
+            std::vector<uint8_t> data;
+            if (readFileBytes(inputs_[index], data))
+            {
+                decoded.image = decodeImage(data.data(), data.size(), min_size.width, min_size.height, &decoded.factor,
+                                            &decoded.source_size);
+            }
+            decoded.decode_ms =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            decoded_.emplace(index, std::move(decoded));
+            decoding_--;
+        }
+        cond_.notify_all();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_workers_--;
+    cond_.notify_all();
+}
+
+void BatchRunner::inferLoop(IModel* model)
+{
+    while (true)
+    {
+        size_t index;
+        Decoded decoded;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() {
+                return stop_ || !decoded_.empty() || (next_decode_ >= end_ && decoding_ == 0);
+            });
+            if (stop_ || decoded_.empty())
+            {
+                break;
+            }
+            // 取最早的已解码条目，使结果尽量按顺序产生
+            auto it = decoded_.begin();
+            index = it->first;
+            decoded = std::move(it->second);
+            decoded_.erase(it);
+        }
+
+        Completed completed;
+        InferenceResult& result = completed.result;
+        result.task_type = model->getTaskType();
+        result.is_success = false;
+        result.inference_time = 0.0f;
+        result.total_time = 0.0f;
+        completed.decode_failed = decoded.image.empty();
+        if (!completed.decode_failed)
+        {
+            result = model->predict(decoded.image);
+            restoreDecodeScale(result, decoded.factor, decoded.source_size);
+            result.total_time += static_cast<float>(decoded.decode_ms);
+        }
+        bool success = result.is_success;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            results_.emplace(index, std::move(completed));
+            if (!success)
+            {
+                stats_.failed++;
+            }
+        }
+        cond_.notify_all();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_workers_--;
+    cond_.notify_all();
+}
+
+void BatchRunner::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+}
+
+BatchStats BatchRunner::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}  // namespace rknn_cpp
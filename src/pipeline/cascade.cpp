@@ -0,0 +1,174 @@
+#include "rknn_cpp/pipeline/cascade.h"
+#include "rknn_cpp/utils/tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iostream>
+
+namespace rknn_cpp
+{
+
+DetectorClassifierCascade::DetectorClassifierCascade(IModel* detector, const std::vector<IModel*>& classifiers,
+                                                     const CascadeConfig& config)
+    : detector_(detector), classifiers_(classifiers), config_(config)
+{
+    config_.crop_padding = std::max(0.0f, config_.crop_padding);
+    config_.min_crop_size = std::max(1, config_.min_crop_size);
+}
+
+bool DetectorClassifierCascade::shouldClassify(const DetectionResult& detection) const
+{
+    if (detection.confidence < config_.min_confidence)
+    {
+        return false;
+    }
+    if (detection.width < config_.min_crop_size || detection.height < config_.min_crop_size)
+    {
+        return false;
+    }
+    return config_.class_filter.empty() || std::find(config_.class_filter.begin(), config_.class_filter.end(),
+                                                     detection.class_id) != config_.class_filter.end();
+}
+
+cv::Rect DetectorClassifierCascade::cropRegion(const DetectionResult& detection, int image_width,
+                                               int image_height) const
+{
+    int pad_x = static_cast<int>(detection.width * config_.crop_padding);
+    int pad_y = static_cast<int>(detection.height * config_.crop_padding);
+    cv::Rect region(detection.x - pad_x, detection.y - pad_y, detection.width + 2 * pad_x,
+                    detection.height + 2 * pad_y);
+    return region & cv::Rect(0, 0, image_width, image_height);
+}
+
+bool DetectorClassifierCascade::classify(const cv::Mat& image, DetectionResults& detections, float* inference_time)
+{
+    RKNN_TRACE_FRAME("Cascade::classify");
+    if (classifiers_.empty())
+    {
+        std::cerr << "Cascade: no classifier" << std::endl;
+        return false;
+    }
+
+    // 收集需要分类的检测框及其裁剪区域
+    std::vector<size_t> targets;
+    std::vector<cv::Rect> regions;
+    for (size_t i = 0; i < detections.size(); i++)
+    {
+        detections[i].classifications.clear();
+        if (!shouldClassify(detections[i]))
+        {
+            continue;
+        }
+        cv::Rect region = cropRegion(detections[i], image.cols, image.rows);
+        if (region.empty())
+        {
+            continue;
+        }
+        targets.push_back(i);
+        regions.push_back(region);
+    }
+    if (targets.empty())
+    {
+        return true;
+    }
+
+    // 每个上下文处理 index % context_count 的检测框，结果直接写回各自的检测框，互不重叠
+    size_t context_count = std::min(classifiers_.size(), targets.size());
+    std::vector<float> inference_times(context_count, 0.0f);
+    std::vector<char> context_ok(context_count, 1);  // 避免vector<bool>的位打包并发写
+
+    auto run_context = [&](size_t c)
+    {
+        // 各裁剪区域属于同一帧
+        RKNN_TRACE_FRAME_CONTINUE();
+        IModel* classifier = classifiers_[c];
+        for (size_t t = c; t < targets.size(); t += context_count)
+        {
+            // ROI推理：在原图视图上缩放与颜色转换，不拷贝裁剪区域
+            InferenceResult crop_result = classifier->predict(image, regions[t]);
+            if (!crop_result.is_success)
+            {
+                context_ok[c] = 0;
+                continue;
+            }
+            inference_times[c] += crop_result.inference_time;
+
+            ClassificationResults classifications = crop_result.getClassifications();
+            if (config_.top_k > 0 && classifications.size() > config_.top_k)
+            {
+                classifications.resize(config_.top_k);
+            }
+            detections[targets[t]].classifications = std::move(classifications);
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (size_t c = 1; c < context_count; c++)
+    {
+        workers.push_back(std::async(std::launch::async, run_context, c));
+    }
+    run_context(0);
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    bool ok = true;
+    float total_time = 0.0f;
+    for (size_t c = 0; c < context_count; c++)
+    {
+        total_time += inference_times[c];
+        if (!context_ok[c])
+        {
+            std::cerr << "[WARN] Some crops failed on classifier context " << c << std::endl;
+            ok = false;
+        }
+    }
+    if (inference_time != nullptr)
+    {
+        *inference_time = total_time;
+    }
+
+    std::cout << "[CASCADE] Classified " << targets.size() << " of " << detections.size() << " detections on "
+              << context_count << " context(s)" << std::endl;
+    return ok;
+}
+
+InferenceResult DetectorClassifierCascade::predict(const cv::Mat& image)
+{
+    RKNN_TRACE_FRAME("Cascade::predict");
+    auto start = std::chrono::steady_clock::now();
+
+    if (detector_ == nullptr || image.empty())
+    {
+        std::cerr << "Cascade: no detector or empty image" << std::endl;
+        InferenceResult result;
+        result.task_type = ModelTask::OBJECT_DETECTION;
+        result.result_data = DetectionResults{};
+        result.is_success = false;
+        result.inference_time = 0.0f;
+        result.total_time = 0.0f;
+        return result;
+    }
+
+    InferenceResult result = detector_->predict(image);
+    if (!result.is_success)
+    {
+        return result;
+    }
+
+    DetectionResults detections = result.getDetections();
+    float classify_time = 0.0f;
+    if (!classify(image, detections, &classify_time))
+    {
+        std::cerr << "[WARN] Cascade classification incomplete" << std::endl;
+    }
+
+    result.result_data = detections;
+    result.inference_time += classify_time;
+    std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - start;
+    result.total_time = total.count();
+    return result;
+}
+
+}  // namespace rknn_cpp
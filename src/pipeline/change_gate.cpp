@@ -0,0 +1,120 @@
+#include "rknn_cpp/pipeline/change_gate.h"
+#include "rknn_cpp/utils/frame_diff.h"
+#include "rknn_cpp/utils/metrics.h"
+#include "rknn_cpp/utils/tracer.h"
+#include <algorithm>
+#include <iostream>
+
+namespace rknn_cpp
+{
+
+FrameChangeGate::FrameChangeGate(const ChangeGateConfig& config) : config_(config)
+{
+    config_.signature_width = std::max(4, config_.signature_width);
+    config_.signature_height = std::max(4, config_.signature_height);
+}
+
+bool FrameChangeGate::check(const cv::Mat& image)
+{
+    RKNN_TRACE_SCOPE("FrameChangeGate::check");
+    computeFrameSignature(image, config_.signature_width, config_.signature_height, current_);
+    last_forced_ = false;
+
+    if (reference_.empty())
+    {
+        last_distance_ = 255.0f;
+        return true;
+    }
+
+    last_distance_ = signatureDistance(current_, reference_);
+    if (last_distance_ > config_.threshold)
+    {
+        return true;
+    }
+
+    // 场景无变化，但复用时间或帧数超出上限时强制推理
+    auto now = std::chrono::steady_clock::now();
+    bool stale_time = config_.max_stale_ms > 0 &&
+                      now - reference_time_ >= std::chrono::milliseconds(config_.max_stale_ms);
+    bool stale_frames = config_.max_stale_frames > 0 && stale_frames_ >= config_.max_stale_frames;
+    if (stale_time || stale_frames)
+    {
+        last_forced_ = true;
+        return true;
+    }
+
+    stale_frames_++;
+    return false;
+}
+
+void FrameChangeGate::accept()
+{
+    std::swap(reference_, current_);
+    reference_time_ = std::chrono::steady_clock::now();
+    stale_frames_ = 0;
+}
+
+void FrameChangeGate::reset()
+{
+    reference_.release();
+    current_.release();
+    stale_frames_ = 0;
+    last_distance_ = 0.0f;
+    last_forced_ = false;
+}
+
+GatedPredictor::GatedPredictor(IModel* model, const ChangeGateConfig& config) : model_(model), gate_(config)
+{
+    MetricsRegistry& registry = MetricsRegistry::instance();
+    std::string labels = "stream=\"" + MetricsRegistry::escapeLabelValue(config.stream_name) + "\"";
+    frames_ = registry.getCounter("rknn_gate_frames_total", "Frames seen by the change gate.", labels);
+    skipped_ = registry.getCounter("rknn_gate_skipped_total", "Frames answered from the cached result.", labels);
+    forced_ = registry.getCounter("rknn_gate_forced_total", "Inferences forced by the staleness limit.", labels);
+}
+
+InferenceResult GatedPredictor::predict(const cv::Mat& image)
+{
+    auto start = std::chrono::steady_clock::now();
+    frames_->fetch_add(1, std::memory_order_relaxed);
+    local_frames_++;
+
+    bool must_infer = gate_.check(image) || !has_cached_result_;
+    if (!must_infer)
+    {
+        // 复用上次结果：不计推理时间，总时间为门控本身的开销
+        skipped_->fetch_add(1, std::memory_order_relaxed);
+        local_skipped_++;
+        InferenceResult result = cached_result_;
+        result.inference_time = 0.0f;
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        result.total_time = elapsed.count();
+        return result;
+    }
+    if (gate_.wasForced())
+    {
+        forced_->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    InferenceResult result = model_->predict(image);
+    if (result.is_success)
+    {
+        gate_.accept();
+        cached_result_ = result;
+        has_cached_result_ = true;
+    }
+    return result;
+}
+
+double GatedPredictor::getHitRate() const
+{
+    return local_frames_ > 0 ? static_cast<double>(local_skipped_) / local_frames_ : 0.0;
+}
+
+void GatedPredictor::reset()
+{
+    gate_.reset();
+    cached_result_ = InferenceResult{};
+    has_cached_result_ = false;
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,158 @@
+#include "rknn_cpp/pipeline/tiled_detector.h"
+#include "rknn_cpp/utils/box_utils.h"
+#include "rknn_cpp/utils/tracer.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <future>
+
+namespace rknn_cpp
+{
+
+TiledDetector::TiledDetector(const std::vector<IModel*>& detectors, const TilingConfig& config)
+    : detectors_(detectors), config_(config)
+{
+    config_.overlap = std::min(std::max(config_.overlap, 0.0f), 0.9f);
+}
+
+// 沿一个维度计算tile起点，最后一个tile与图像边缘对齐
+static std::vector<int> computeTileStarts(int image_size, int tile_size, float overlap)
+{
+    std::vector<int> starts;
+    if (tile_size >= image_size)
+    {
+        starts.push_back(0);
+        return starts;
+    }
+
+    int step = std::max(1, static_cast<int>(tile_size * (1.0f - overlap)));
+    for (int pos = 0;; pos += step)
+    {
+        if (pos + tile_size >= image_size)
+        {
+            starts.push_back(image_size - tile_size);
+            break;
+        }
+        starts.push_back(pos);
+    }
+    return starts;
+}
+
+std::vector<cv::Rect> TiledDetector::computeTiles(int image_width, int image_height) const
+{
+    std::vector<cv::Rect> tiles;
+    if (detectors_.empty() || image_width <= 0 || image_height <= 0)
+    {
+        return tiles;
+    }
+
+    int tile_w = config_.tile_width > 0 ? config_.tile_width : detectors_[0]->getModelWidth();
+    int tile_h = config_.tile_height > 0 ? config_.tile_height : detectors_[0]->getModelHeight();
+    tile_w = std::min(tile_w, image_width);
+    tile_h = std::min(tile_h, image_height);
+
+    for (int y : computeTileStarts(image_height, tile_h, config_.overlap))
+    {
+        for (int x : computeTileStarts(image_width, tile_w, config_.overlap))
+        {
+            tiles.emplace_back(x, y, tile_w, tile_h);
+        }
+    }
+    return tiles;
+}
+
+InferenceResult TiledDetector::predict(const cv::Mat& image)
+{
+    RKNN_TRACE_FRAME("TiledDetector::predict");
+    auto start = std::chrono::steady_clock::now();
+
+    InferenceResult result;
+    result.task_type = ModelTask::OBJECT_DETECTION;
+    result.result_data = DetectionResults{};
+    result.is_success = false;
+    result.inference_time = 0.0f;
+    result.total_time = 0.0f;
+
+    if (detectors_.empty() || image.empty())
+    {
+        std::cerr << "TiledDetector: no detector or empty image" << std::endl;
+        return result;
+    }
+
+    std::vector<cv::Rect> tiles = computeTiles(image.cols, image.rows);
+    bool whole_image = tiles.size() == 1 && tiles[0].width == image.cols && tiles[0].height == image.rows;
+
+    // 整图推理作为一个全图大小的"tile"加入任务列表
+    if (config_.global_pass && !whole_image)
+    {
+        tiles.emplace_back(0, 0, image.cols, image.rows);
+    }
+
+    std::cout << "\n[TILING] " << image.cols << " x " << image.rows << " -> " << tiles.size() << " tiles on "
+              << detectors_.size() << " context(s)" << std::endl;
+
+    // 每个上下文处理 index % context_count 的tile
+    size_t context_count = std::min(detectors_.size(), tiles.size());
+    std::vector<DetectionResults> per_context(context_count);
+    std::vector<float> inference_times(context_count, 0.0f);
+    std::vector<char> context_ok(context_count, 1);  // 避免vector<bool>的位打包并发写
+
+    auto run_context = [&](size_t c)
+    {
+        // 各tile属于同一帧
+        RKNN_TRACE_FRAME_CONTINUE();
+        IModel* detector = detectors_[c];
+        for (size_t t = c; t < tiles.size(); t += context_count)
+        {
+            const cv::Rect& tile = tiles[t];
+            // ROI推理：直接在原图视图上预处理，结果已是整图坐标
+            InferenceResult tile_result = detector->predict(image, tile);
+            if (!tile_result.is_success)
+            {
+                context_ok[c] = 0;
+                continue;
+            }
+            inference_times[c] += tile_result.inference_time;
+
+            DetectionResults detections = tile_result.getDetections();
+            per_context[c].insert(per_context[c].end(), detections.begin(), detections.end());
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (size_t c = 1; c < context_count; c++)
+    {
+        workers.push_back(std::async(std::launch::async, run_context, c));
+    }
+    run_context(0);
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    DetectionResults merged;
+    for (size_t c = 0; c < context_count; c++)
+    {
+        merged.insert(merged.end(), per_context[c].begin(), per_context[c].end());
+        result.inference_time += inference_times[c];
+        if (!context_ok[c])
+        {
+            std::cerr << "[WARN] Some tiles failed on context " << c << std::endl;
+        }
+    }
+
+    size_t before_merge = merged.size();
+    {
+        RKNN_TRACE_SCOPE("TiledDetector::merge");
+        nmsDetections(merged, config_.merge_threshold, config_.merge_use_ios);
+    }
+    std::cout << "[TILING] Merged " << before_merge << " tile detections into " << merged.size() << std::endl;
+
+    result.result_data = merged;
+    result.is_success = true;
+    std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - start;
+    result.total_time = total.count();
+    return result;
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,397 @@
+#include "rknn_cpp/pipeline/tracker.h"
+#include "rknn_cpp/utils/tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+
+namespace rknn_cpp
+{
+
+// 噪声与框高成比例（ByteTrack的取值），使远近目标的滤波行为一致
+static constexpr float kPositionNoise = 1.0f / 20.0f;
+static constexpr float kVelocityNoise = 1.0f / 160.0f;
+
+// ===== KalmanBoxFilter =====
+
+KalmanBoxFilter::KalmanBoxFilter(const cv::Rect2f& box)
+{
+    const float measurements[4] = {box.x + box.width * 0.5f, box.y + box.height * 0.5f, box.width, box.height};
+    const float pos_std = 2.0f * kPositionNoise * box.height;
+    const float vel_std = 10.0f * kVelocityNoise * box.height;
+    for (int i = 0; i < 4; i++)
+    {
+        axes_[i].pos = measurements[i];
+        axes_[i].vel = 0.0f;
+        axes_[i].p00 = pos_std * pos_std;
+        axes_[i].p01 = 0.0f;
+        axes_[i].p11 = vel_std * vel_std;
+    }
+}
+
+void KalmanBoxFilter::predictAxis(Axis& axis, float dt, float noise) const
+{
+    // F = [[1, dt], [0, 1]]，P = F P F^T + Q
+    float q_pos = kPositionNoise * noise;
+    float q_vel = kVelocityNoise * noise;
+    axis.pos += axis.vel * dt;
+    axis.p00 += dt * (2.0f * axis.p01 + dt * axis.p11) + q_pos * q_pos;
+    axis.p01 += dt * axis.p11;
+    axis.p11 += q_vel * q_vel;
+}
+
+void KalmanBoxFilter::updateAxis(Axis& axis, float measurement, float noise) const
+{
+    // H = [1, 0]
+    float r = kPositionNoise * noise;
+    float s = axis.p00 + r * r;
+    float k0 = axis.p00 / s;
+    float k1 = axis.p01 / s;
+    float innovation = measurement - axis.pos;
+    axis.pos += k0 * innovation;
+    axis.vel += k1 * innovation;
+    float p01 = axis.p01;
+    axis.p11 -= k1 * p01;
+    axis.p01 = (1.0f - k0) * p01;
+    axis.p00 = (1.0f - k0) * axis.p00;
+}
+
+cv::Rect2f KalmanBoxFilter::predict(float frames)
+{
+    float noise = std::max(1.0f, axes_[3].pos);
+    for (auto& axis : axes_)
+    {
+        predictAxis(axis, frames, noise);
+    }
+    return getBox();
+}
+
+void KalmanBoxFilter::update(const cv::Rect2f& box)
+{
+    const float measurements[4] = {box.x + box.width * 0.5f, box.y + box.height * 0.5f, box.width, box.height};
+    float noise = std::max(1.0f, box.height);
+    for (int i = 0; i < 4; i++)
+    {
+        updateAxis(axes_[i], measurements[i], noise);
+    }
+}
+
+cv::Rect2f KalmanBoxFilter::getBox() const
+{
+    float width = std::max(1.0f, axes_[2].pos);
+    float height = std::max(1.0f, axes_[3].pos);
+    return cv::Rect2f(axes_[0].pos - width * 0.5f, axes_[1].pos - height * 0.5f, width, height);
+}
+
+// ===== MultiObjectTracker =====
+
+static cv::Rect2f toRect(const DetectionResult& detection)
+{
+    return cv::Rect2f(detection.x, detection.y, detection.width, detection.height);
+}
+
+static void assignBox(DetectionResult& detection, const cv::Rect2f& box)
+{
+    float x = std::max(0.0f, box.x);
+    float y = std::max(0.0f, box.y);
+    detection.x = static_cast<uint16_t>(std::min(x, 65535.0f));
+    detection.y = static_cast<uint16_t>(std::min(y, 65535.0f));
+    detection.width = static_cast<uint16_t>(std::min(std::max(0.0f, box.x + box.width - x), 65535.0f));
+    detection.height = static_cast<uint16_t>(std::min(std::max(0.0f, box.y + box.height - y), 65535.0f));
+}
+
+MultiObjectTracker::MultiObjectTracker(const TrackerConfig& config) : config_(config)
+{
+}
+
+void MultiObjectTracker::associate(const std::vector<size_t>& track_indices, const DetectionResults& detections,
+                                   const std::vector<size_t>& det_indices, std::vector<int>& track_to_det,
+                                   std::vector<char>& det_used) const
+{
+    if (track_indices.empty() || det_indices.empty())
+    {
+        return;
+    }
+
+    BoxArray det_boxes;
+    det_boxes.reserve(det_indices.size());
+    for (size_t d : det_indices)
+    {
+        const auto& det = detections[d];
+        det_boxes.push_back(det.x, det.y, det.x + det.width, det.y + det.height);
+    }
+
+    // 收集IoU超过阈值的(轨迹, 检测)对，按IoU降序贪心匹配
+    std::vector<std::tuple<float, size_t, size_t>> candidates;
+    std::vector<float> ious(det_indices.size());
+    for (size_t t : track_indices)
+    {
+        if (track_to_det[t] >= 0)
+        {
+            continue;
+        }
+        cv::Rect2f box = tracks_[t].filter.getBox();
+        overlapOneToMany(box.x, box.y, box.x + box.width, box.y + box.height, det_boxes, 0, det_indices.size(),
+                         ious.data());
+        for (size_t k = 0; k < det_indices.size(); k++)
+        {
+            size_t d = det_indices[k];
+            if (det_used[d] || ious[k] < config_.match_iou)
+            {
+                continue;
+            }
+            if (config_.class_aware && detections[d].class_id != tracks_[t].detection.class_id)
+            {
+                continue;
+            }
+            candidates.emplace_back(ious[k], t, d);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+
+    for (const auto& candidate : candidates)
+    {
+        size_t t = std::get<1>(candidate);
+        size_t d = std::get<2>(candidate);
+        if (track_to_det[t] >= 0 || det_used[d])
+        {
+            continue;
+        }
+        track_to_det[t] = static_cast<int>(d);
+        det_used[d] = 1;
+    }
+}
+
+DetectionResults MultiObjectTracker::update(const DetectionResults& detections, float frames_since_last)
+{
+    RKNN_TRACE_SCOPE("MultiObjectTracker::update");
+    for (auto& track : tracks_)
+    {
+        track.filter.predict(frames_since_last);
+    }
+
+    std::vector<size_t> high;
+    std::vector<size_t> low;
+    for (size_t d = 0; d < detections.size(); d++)
+    {
+        if (detections[d].confidence >= config_.high_threshold)
+        {
+            high.push_back(d);
+        }
+        else if (detections[d].confidence >= config_.low_threshold)
+        {
+            low.push_back(d);
+        }
+    }
+
+    // 第一阶段：全部轨迹与高分检测关联；第二阶段：剩余轨迹与低分检测关联（找回被遮挡的目标）
+    std::vector<int> track_to_det(tracks_.size(), -1);
+    std::vector<char> det_used(detections.size(), 0);
+    std::vector<size_t> all_tracks(tracks_.size());
+    for (size_t t = 0; t < tracks_.size(); t++)
+    {
+        all_tracks[t] = t;
+    }
+    associate(all_tracks, detections, high, track_to_det, det_used);
+
+    std::vector<size_t> remaining;
+    for (size_t t = 0; t < tracks_.size(); t++)
+    {
+        if (track_to_det[t] < 0 && tracks_[t].confirmed)
+        {
+            remaining.push_back(t);
+        }
+    }
+    associate(remaining, detections, low, track_to_det, det_used);
+
+    last_created_ = 0;
+    last_removed_ = 0;
+    std::vector<Track> kept;
+    kept.reserve(tracks_.size() + high.size());
+    for (size_t t = 0; t < tracks_.size(); t++)
+    {
+        Track& track = tracks_[t];
+        if (track_to_det[t] >= 0)
+        {
+            const DetectionResult& det = detections[track_to_det[t]];
+            track.filter.update(toRect(det));
+            track.detection = det;
+            track.detection.track_id = track.track_id;
+            assignBox(track.detection, track.filter.getBox());
+            track.hits++;
+            track.misses = 0;
+            track.confirmed = track.confirmed || track.hits >= config_.min_hits;
+            kept.push_back(std::move(track));
+            continue;
+        }
+
+        // 未确认的轨迹一次未匹配即删除；已确认的轨迹保留max_age帧
+        track.misses++;
+        if (!track.confirmed)
+        {
+            continue;
+        }
+        if (track.misses > config_.max_age)
+        {
+            last_removed_++;
+            continue;
+        }
+        kept.push_back(std::move(track));
+    }
+
+    for (size_t d : high)
+    {
+        if (det_used[d])
+        {
+            continue;
+        }
+        Track track;
+        track.track_id = next_id_++;
+        track.filter = KalmanBoxFilter(toRect(detections[d]));
+        track.detection = detections[d];
+        track.detection.track_id = track.track_id;
+        track.hits = 1;
+        track.confirmed = config_.min_hits <= 1;
+        kept.push_back(std::move(track));
+        last_created_++;
+    }
+    tracks_.swap(kept);
+
+    return collectOutputs();
+}
+
+DetectionResults MultiObjectTracker::predict(float frames_since_last)
+{
+    for (auto& track : tracks_)
+    {
+        assignBox(track.detection, track.filter.predict(frames_since_last));
+    }
+    return collectOutputs();
+}
+
+DetectionResults MultiObjectTracker::collectOutputs() const
+{
+    // 只输出已确认且在最近一次检测中匹配的轨迹
+    DetectionResults outputs;
+    for (const auto& track : tracks_)
+    {
+        if (track.confirmed && track.misses == 0)
+        {
+            outputs.push_back(track.detection);
+        }
+    }
+    return outputs;
+}
+
+void MultiObjectTracker::reset()
+{
+    tracks_.clear();
+    next_id_ = 1;
+    last_created_ = 0;
+    last_removed_ = 0;
+}
+
+// ===== DetectionScheduler =====
+
+DetectionScheduler::DetectionScheduler(const DetectionScheduleConfig& config) : config_(config)
+{
+    config_.min_stride = std::max(1, config_.min_stride);
+    config_.max_stride = std::max(config_.min_stride, config_.max_stride);
+    config_.stable_to_increase = std::max(1, config_.stable_to_increase);
+    reset();
+}
+
+bool DetectionScheduler::shouldDetect()
+{
+    if (frames_since_detect_ + 1 >= stride_)
+    {
+        frames_since_detect_ = 0;
+        return true;
+    }
+    frames_since_detect_++;
+    return false;
+}
+
+void DetectionScheduler::report(int created, int removed)
+{
+    if (created > 0 || removed > 0)
+    {
+        stride_ = config_.min_stride;
+        stable_count_ = 0;
+        return;
+    }
+    if (++stable_count_ >= config_.stable_to_increase)
+    {
+        stride_ = std::min(stride_ + 1, config_.max_stride);
+        stable_count_ = 0;
+    }
+}
+
+void DetectionScheduler::reset()
+{
+    stride_ = config_.min_stride;
+    frames_since_detect_ = config_.max_stride;  // 第一帧总是检测
+    stable_count_ = 0;
+}
+
+// ===== TrackingDetector =====
+
+TrackingDetector::TrackingDetector(IModel* detector, const TrackerConfig& tracker_config,
+                                   const DetectionScheduleConfig& schedule_config)
+    : detector_(detector), tracker_(tracker_config), scheduler_(schedule_config)
+{
+}
+
+InferenceResult TrackingDetector::predict(const cv::Mat& image)
+{
+    RKNN_TRACE_FRAME("TrackingDetector::predict");
+    auto start = std::chrono::steady_clock::now();
+
+    DetectionResults tracked;
+    InferenceResult result;
+    result.task_type = ModelTask::OBJECT_DETECTION;
+    result.is_success = true;
+    result.inference_time = 0.0f;
+
+    bool detected = false;
+    if (scheduler_.shouldDetect())
+    {
+        InferenceResult detection = detector_->predict(image);
+        result.is_success = detection.is_success;
+        if (detection.is_success)
+        {
+            tracked = tracker_.update(detection.getDetections());
+            scheduler_.report(tracker_.getLastCreated(), tracker_.getLastRemoved());
+            result.inference_time = detection.inference_time;
+            detected = true;
+        }
+    }
+    if (!detected)
+    {
+        tracked = tracker_.predict();
+    }
+
+    // 外推的框裁剪到图像范围内
+    cv::Rect bounds(0, 0, image.cols, image.rows);
+    for (auto& det : tracked)
+    {
+        cv::Rect box = cv::Rect(det.x, det.y, det.width, det.height) & bounds;
+        det.x = static_cast<uint16_t>(box.x);
+        det.y = static_cast<uint16_t>(box.y);
+        det.width = static_cast<uint16_t>(std::max(0, box.width));
+        det.height = static_cast<uint16_t>(std::max(0, box.height));
+    }
+
+    result.result_data = tracked;
+    std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - start;
+    result.total_time = total.count();
+    return result;
+}
+
+void TrackingDetector::reset()
+{
+    tracker_.reset();
+    scheduler_.reset();
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,233 @@
+#include "rknn_cpp/utils/box_utils.h"
+#include <algorithm>
+#include <numeric>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RKNN_CPP_USE_NEON 1
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#define RKNN_CPP_USE_SSE 1
+#endif
+
+namespace rknn_cpp
+{
+
+float calculateIoU(float xmin0, float ymin0, float xmax0, float ymax0, float xmin1, float ymin1, float xmax1,
+                   float ymax1)
+{
+    // 计算交集区域
+    float inter_xmin = std::max(xmin0, xmin1);
+    float inter_ymin = std::max(ymin0, ymin1);
+    float inter_xmax = std::min(xmax0, xmax1);
+    float inter_ymax = std::min(ymax0, ymax1);
+
+    // 检查是否有交集
+    if (inter_xmin >= inter_xmax || inter_ymin >= inter_ymax)
+    {
+        return 0.0f;
+    }
+
+    // 计算交集面积
+    float inter_area = (inter_xmax - inter_xmin) * (inter_ymax - inter_ymin);
+
+    // 计算并集面积
+    float area0 = (xmax0 - xmin0) * (ymax0 - ymin0);
+    float area1 = (xmax1 - xmin1) * (ymax1 - ymin1);
+    float union_area = area0 + area1 - inter_area;
+
+    // 避免除零
+    if (union_area <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return inter_area / union_area;
+}
+
+float calculateIoS(float xmin0, float ymin0, float xmax0, float ymax0, float xmin1, float ymin1, float xmax1,
+                   float ymax1)
+{
+    float inter_xmin = std::max(xmin0, xmin1);
+    float inter_ymin = std::max(ymin0, ymin1);
+    float inter_xmax = std::min(xmax0, xmax1);
+    float inter_ymax = std::min(ymax0, ymax1);
+
+    if (inter_xmin >= inter_xmax || inter_ymin >= inter_ymax)
+    {
+        return 0.0f;
+    }
+
+    float inter_area = (inter_xmax - inter_xmin) * (inter_ymax - inter_ymin);
+    float min_area = std::min((xmax0 - xmin0) * (ymax0 - ymin0), (xmax1 - xmin1) * (ymax1 - ymin1));
+    if (min_area <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return inter_area / min_area;
+}
+
+void BoxArray::reserve(size_t n)
+{
+    xmin.reserve(n);
+    ymin.reserve(n);
+    xmax.reserve(n);
+    ymax.reserve(n);
+}
+
+void BoxArray::clear()
+{
+    xmin.clear();
+    ymin.clear();
+    xmax.clear();
+    ymax.clear();
+}
+
+void BoxArray::push_back(float x0, float y0, float x1, float y1)
+{
+    xmin.push_back(x0);
+    ymin.push_back(y0);
+    xmax.push_back(x1);
+    ymax.push_back(y1);
+}
+
+void overlapOneToMany(float xmin, float ymin, float xmax, float ymax, const BoxArray& boxes, size_t begin,
+                      size_t end, float* out, bool use_ios)
+{
+    const float area0 = (xmax - xmin) * (ymax - ymin);
+    size_t i = begin;
+
+#if defined(RKNN_CPP_USE_NEON) || defined(RKNN_CPP_USE_SSE)
+    // 无交集时交集宽或高截断为0，分母不大于0时结果为0，与标量版本一致
+#if defined(RKNN_CPP_USE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t vxmin = vdupq_n_f32(xmin), vymin = vdupq_n_f32(ymin);
+    const float32x4_t vxmax = vdupq_n_f32(xmax), vymax = vdupq_n_f32(ymax);
+    const float32x4_t varea0 = vdupq_n_f32(area0);
+    for (; i + 4 <= end; i += 4)
+    {
+        float32x4_t bx0 = vld1q_f32(&boxes.xmin[i]), by0 = vld1q_f32(&boxes.ymin[i]);
+        float32x4_t bx1 = vld1q_f32(&boxes.xmax[i]), by1 = vld1q_f32(&boxes.ymax[i]);
+        float32x4_t iw = vmaxq_f32(vsubq_f32(vminq_f32(vxmax, bx1), vmaxq_f32(vxmin, bx0)), zero);
+        float32x4_t ih = vmaxq_f32(vsubq_f32(vminq_f32(vymax, by1), vmaxq_f32(vymin, by0)), zero);
+        float32x4_t inter = vmulq_f32(iw, ih);
+        float32x4_t area1 = vmulq_f32(vsubq_f32(bx1, bx0), vsubq_f32(by1, by0));
+        float32x4_t denom = use_ios ? vminq_f32(varea0, area1) : vsubq_f32(vaddq_f32(varea0, area1), inter);
+        uint32x4_t valid = vandq_u32(vcgtq_f32(denom, zero), vcgtq_f32(inter, zero));
+        float32x4_t ratio = vdivq_f32(inter, vbslq_f32(valid, denom, vdupq_n_f32(1.0f)));
+        vst1q_f32(out + (i - begin), vbslq_f32(valid, ratio, zero));
+    }
+#else
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 vxmin = _mm_set1_ps(xmin), vymin = _mm_set1_ps(ymin);
+    const __m128 vxmax = _mm_set1_ps(xmax), vymax = _mm_set1_ps(ymax);
+    const __m128 varea0 = _mm_set1_ps(area0);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 bx0 = _mm_loadu_ps(&boxes.xmin[i]), by0 = _mm_loadu_ps(&boxes.ymin[i]);
+        __m128 bx1 = _mm_loadu_ps(&boxes.xmax[i]), by1 = _mm_loadu_ps(&boxes.ymax[i]);
+        __m128 iw = _mm_max_ps(_mm_sub_ps(_mm_min_ps(vxmax, bx1), _mm_max_ps(vxmin, bx0)), zero);
+        __m128 ih = _mm_max_ps(_mm_sub_ps(_mm_min_ps(vymax, by1), _mm_max_ps(vymin, by0)), zero);
+        __m128 inter = _mm_mul_ps(iw, ih);
+        __m128 area1 = _mm_mul_ps(_mm_sub_ps(bx1, bx0), _mm_sub_ps(by1, by0));
+        __m128 denom = use_ios ? _mm_min_ps(varea0, area1) : _mm_sub_ps(_mm_add_ps(varea0, area1), inter);
+        __m128 valid = _mm_and_ps(_mm_cmpgt_ps(denom, zero), _mm_cmpgt_ps(inter, zero));
+        __m128 safe = _mm_or_ps(_mm_and_ps(valid, denom), _mm_andnot_ps(valid, _mm_set1_ps(1.0f)));
+        _mm_storeu_ps(out + (i - begin), _mm_and_ps(valid, _mm_div_ps(inter, safe)));
+    }
+#endif
+#endif
+
+    for (; i < end; i++)
+    {
+        out[i - begin] = use_ios ? calculateIoS(xmin, ymin, xmax, ymax, boxes.xmin[i], boxes.ymin[i], boxes.xmax[i],
+                                                boxes.ymax[i])
+                                 : calculateIoU(xmin, ymin, xmax, ymax, boxes.xmin[i], boxes.ymin[i], boxes.xmax[i],
+                                                boxes.ymax[i]);
+    }
+}
+
+std::vector<int> nmsBoxes(const std::vector<float>& boxes, const std::vector<float>& scores,
+                          const std::vector<int>& classIds, float nms_threshold, bool use_ios)
+{
+    int validCount = static_cast<int>(boxes.size() / 4);
+    if (validCount == 0)
+    {
+        return {};
+    }
+
+    // 创建索引数组并按置信度降序排序
+    std::vector<int> order(validCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&scores](int a, int b) { return scores[a] > scores[b]; });
+
+    // 按排序后的顺序整理为结构数组，便于一个框对后续全部框批量计算重叠度
+    BoxArray sorted;
+    sorted.reserve(validCount);
+    std::vector<int> sorted_class(validCount);
+    for (int i = 0; i < validCount; ++i)
+    {
+        int n = order[i];
+        sorted.push_back(boxes[n * 4 + 0], boxes[n * 4 + 1], boxes[n * 4 + 0] + boxes[n * 4 + 2],
+                         boxes[n * 4 + 1] + boxes[n * 4 + 3]);
+        sorted_class[i] = classIds[n];
+    }
+
+    // 各类别相互独立、都按置信度降序处理，因此可在一次遍历中完成按类别的NMS
+    std::vector<char> suppressed(validCount, 0);
+    std::vector<float> overlaps(validCount);
+    std::vector<int> keep_indices;
+    for (int i = 0; i < validCount; ++i)
+    {
+        if (suppressed[i])
+        {
+            continue;
+        }
+        keep_indices.push_back(order[i]);
+
+        overlapOneToMany(sorted.xmin[i], sorted.ymin[i], sorted.xmax[i], sorted.ymax[i], sorted, i + 1, validCount,
+                         overlaps.data(), use_ios);
+        for (int j = i + 1; j < validCount; ++j)
+        {
+            // 如果重叠超过阈值，抑制同类别中置信度较低的框
+            if (overlaps[j - i - 1] > nms_threshold && sorted_class[j] == sorted_class[i])
+            {
+                suppressed[j] = 1;
+            }
+        }
+    }
+    return keep_indices;
+}
+
+void nmsDetections(DetectionResults& detections, float nms_threshold, bool use_ios)
+{
+    std::vector<float> boxes;
+    std::vector<float> scores;
+    std::vector<int> classIds;
+    boxes.reserve(detections.size() * 4);
+    scores.reserve(detections.size());
+    classIds.reserve(detections.size());
+
+    for (const auto& d : detections)
+    {
+        boxes.push_back(d.x);
+        boxes.push_back(d.y);
+        boxes.push_back(d.width);
+        boxes.push_back(d.height);
+        scores.push_back(d.confidence);
+        classIds.push_back(d.class_id);
+    }
+
+    std::vector<int> keep = nmsBoxes(boxes, scores, classIds, nms_threshold, use_ios);
+
+    DetectionResults kept;
+    kept.reserve(keep.size());
+    for (int idx : keep)
+    {
+        kept.push_back(std::move(detections[idx]));
+    }
+    detections.swap(kept);
+}
+
+}  // namespace rknn_cpp
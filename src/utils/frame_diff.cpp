@@ -0,0 +1,96 @@
+#include "rknn_cpp/utils/frame_diff.h"
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RKNN_CPP_USE_NEON 1
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#define RKNN_CPP_USE_SSE 1
+#endif
+
+namespace rknn_cpp
+{
+
+namespace reference
+{
+uint64_t sumAbsDiffU8(const uint8_t* a, const uint8_t* b, size_t count)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        sum += static_cast<uint64_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+    }
+    return sum;
+}
+}  // namespace reference
+
+uint64_t sumAbsDiffU8(const uint8_t* a, const uint8_t* b, size_t count)
+{
+    size_t i = 0;
+    uint64_t sum = 0;
+#if defined(RKNN_CPP_USE_NEON)
+    // vabd得到逐字节差，vpadal每次向每个16位通道加两个字节（最多510）；
+    // 每2048字节（128次）归并一次防止16位溢出（128 * 510 = 65280 < 65536）
+    while (i + 16 <= count)
+    {
+        uint16x8_t acc = vdupq_n_u16(0);
+        size_t block_end = std::min(count - (count - i) % 16, i + 2048);
+        for (; i < block_end; i += 16)
+        {
+            acc = vpadalq_u8(acc, vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+        }
+        sum += vaddlvq_u16(acc);
+    }
+#elif defined(RKNN_CPP_USE_SSE)
+    // psadbw直接给出每8字节的SAD，累加到64位通道，无溢出问题
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+    }
+    // _mm_cvtsi128_si64仅x86-64可用，经内存取出两个64位通道，32位x86同样适用
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    sum = lanes[0] + lanes[1];
+#endif
+    return sum + reference::sumAbsDiffU8(a + i, b + i, count - i);
+}
+
+void computeFrameSignature(const cv::Mat& image, int width, int height, cv::Mat& signature)
+{
+    // 先缩小再转灰度，颜色转换只处理很少的像素
+    cv::Mat small;
+    cv::resize(image, small, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+    if (small.channels() == 3)
+    {
+        cv::cvtColor(small, signature, cv::COLOR_BGR2GRAY);
+    }
+    else if (small.channels() == 4)
+    {
+        cv::cvtColor(small, signature, cv::COLOR_BGRA2GRAY);
+    }
+    else
+    {
+        signature = small;
+    }
+    if (!signature.isContinuous())
+    {
+        signature = signature.clone();
+    }
+}
+
+float signatureDistance(const cv::Mat& a, const cv::Mat& b)
+{
+    if (a.empty() || a.rows != b.rows || a.cols != b.cols || a.type() != b.type())
+    {
+        return 255.0f;
+    }
+    size_t count = a.total() * a.elemSize();
+    return static_cast<float>(sumAbsDiffU8(a.data, b.data, count)) / static_cast<float>(count);
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,265 @@
+#include "rknn_cpp/utils/image_decode.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace rknn_cpp
+{
+
+bool readJpegSize(const uint8_t* data, size_t size, int& width, int& height)
+{
+    if (data == nullptr || size < 4 || data[0] != 0xFF || data[1] != 0xD8)
+    {
+        return false;
+    }
+
+    // 依次跳过各段直到SOFn（C0-CF，除去DHT C4、JPG C8、DAC CC）
+    size_t pos = 2;
+    while (pos + 4 <= size)
+    {
+        if (data[pos] != 0xFF)
+        {
+            return false;
+        }
+        uint8_t marker = data[pos + 1];
+        if (marker == 0xFF)
+        {
+            pos++;  // 填充字节
+            continue;
+        }
+        if (marker == 0xD8 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+        {
+            pos += 2;  // 无长度字段的标记
+            continue;
+        }
+        if (marker == 0xD9 || marker == 0xDA)
+        {
+            return false;  // 在SOF之前遇到扫描数据或结束
+        }
+
+        size_t length = (static_cast<size_t>(data[pos + 2]) << 8) | data[pos + 3];
+        if (length < 2 || pos + 2 + length > size)
+        {
+            return false;
+        }
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+        {
+            // SOF: 长度(2) 精度(1) 高(2) 宽(2)
+            if (length < 7)
+            {
+                return false;
+            }
+            height = (data[pos + 5] << 8) | data[pos + 6];
+            width = (data[pos + 7] << 8) | data[pos + 8];
+            return width > 0 && height > 0;
+        }
+        pos += 2 + length;
+    }
+    return false;
+}
+
+static uint16_t readExifU16(const uint8_t* p, bool little_endian)
+{
+    return little_endian ? static_cast<uint16_t>(p[0] | (p[1] << 8)) : static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+static uint32_t readExifU32(const uint8_t* p, bool little_endian)
+{
+    return little_endian ? (static_cast<uint32_t>(readExifU16(p + 2, true)) << 16) | readExifU16(p, true)
+                         : (static_cast<uint32_t>(readExifU16(p, false)) << 16) | readExifU16(p + 2, false);
+}
+
+// 在Exif负载（"Exif\0\0"之后的TIFF数据）的IFD0中查找方向标签
+static int parseExifOrientation(const uint8_t* tiff, size_t size)
+{
+    if (size < 8)
+    {
+        return 1;
+    }
+    bool little_endian;
+    if (tiff[0] == 'I' && tiff[1] == 'I')
+    {
+        little_endian = true;
+    }
+    else if (tiff[0] == 'M' && tiff[1] == 'M')
+    {
+        little_endian = false;
+    }
+    else
+    {
+        return 1;
+    }
+    if (readExifU16(tiff + 2, little_endian) != 0x2A)
+    {
+        return 1;
+    }
+    size_t ifd = readExifU32(tiff + 4, little_endian);
+    if (ifd > size - 2)
+    {
+        return 1;
+    }
+    size_t count = readExifU16(tiff + ifd, little_endian);
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t entry = ifd + 2 + i * 12;
+        if (entry + 12 > size)
+        {
+            break;
+        }
+        // 条目: 标签(2) 类型(2) 个数(4) 值(4)，方向为SHORT，值存放在值字段的前两个字节
+        if (readExifU16(tiff + entry, little_endian) == 0x0112)
+        {
+            int orientation = readExifU16(tiff + entry + 8, little_endian);
+            return orientation >= 1 && orientation <= 8 ? orientation : 1;
+        }
+    }
+    return 1;
+}
+
+int readJpegOrientation(const uint8_t* data, size_t size)
+{
+    if (data == nullptr || size < 4 || data[0] != 0xFF || data[1] != 0xD8)
+    {
+        return 1;
+    }
+
+    // Exif在APP1段中，位于SOF之前
+    size_t pos = 2;
+    while (pos + 4 <= size)
+    {
+        if (data[pos] != 0xFF)
+        {
+            return 1;
+        }
+        uint8_t marker = data[pos + 1];
+        if (marker == 0xFF)
+        {
+            pos++;
+            continue;
+        }
+        if (marker == 0xD8 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+        {
+            pos += 2;
+            continue;
+        }
+        if (marker == 0xD9 || marker == 0xDA || (marker >= 0xC0 && marker <= 0xCF))
+        {
+            return 1;
+        }
+
+        size_t length = (static_cast<size_t>(data[pos + 2]) << 8) | data[pos + 3];
+        if (length < 2 || pos + 2 + length > size)
+        {
+            return 1;
+        }
+        const uint8_t* payload = data + pos + 4;
+        size_t payload_size = length - 2;
+        if (marker == 0xE1 && payload_size >= 6 && memcmp(payload, "Exif\0\0", 6) == 0)
+        {
+            return parseExifOrientation(payload + 6, payload_size - 6);
+        }
+        pos += 2 + length;
+    }
+    return 1;
+}
+
+int selectReducedFactor(int src_width, int src_height, int dst_width, int dst_height)
+{
+    // libjpeg缩放后尺寸向上取整
+    for (int factor = 8; factor > 1; factor /= 2)
+    {
+        if ((src_width + factor - 1) / factor >= dst_width && (src_height + factor - 1) / factor >= dst_height)
+        {
+            return factor;
+        }
+    }
+    return 1;
+}
+
+static int reducedColorFlag(int factor)
+{
+    switch (factor)
+    {
+        case 8:
+            return cv::IMREAD_REDUCED_COLOR_8;
+        case 4:
+            return cv::IMREAD_REDUCED_COLOR_4;
+        case 2:
+            return cv::IMREAD_REDUCED_COLOR_2;
+        default:
+            return cv::IMREAD_COLOR;
+    }
+}
+
+cv::Mat decodeImage(const uint8_t* data, size_t size, int min_width, int min_height, int* factor,
+                    cv::Size* source_size)
+{
+    int used_factor = 1;
+    int width = 0;
+    int height = 0;
+    bool is_jpeg = readJpegSize(data, size, width, height);
+    if (is_jpeg && readJpegOrientation(data, size) >= 5)
+    {
+        // imdecode按EXIF旋转90度，解码结果宽高互换
+        std::swap(width, height);
+    }
+    if (is_jpeg && min_width > 0 && min_height > 0)
+    {
+        used_factor = selectReducedFactor(width, height, min_width, min_height);
+    }
+    if (factor != nullptr)
+    {
+        *factor = used_factor;
+    }
+
+    // 不拷贝数据，直接包装为单行Mat
+    const cv::Mat encoded(1, static_cast<int>(size), CV_8UC1, const_cast<uint8_t*>(data));
+    cv::Mat image = cv::imdecode(encoded, reducedColorFlag(used_factor));
+    if (source_size != nullptr)
+    {
+        *source_size = is_jpeg ? cv::Size(width, height) : image.size();
+    }
+    return image;
+}
+
+void restoreDecodeScale(InferenceResult& result, int factor, const cv::Size& source_size)
+{
+    auto* detections = std::any_cast<DetectionResults>(&result.result_data);
+    if (factor <= 1 || !result.is_success || detections == nullptr)
+    {
+        return;
+    }
+    const int full_width = std::min(source_size.width, 65535);
+    const int full_height = std::min(source_size.height, 65535);
+    for (auto& det : *detections)
+    {
+        int x = std::min(det.x * factor, full_width);
+        int y = std::min(det.y * factor, full_height);
+        det.width = static_cast<uint16_t>(std::min(det.width * factor, full_width - x));
+        det.height = static_cast<uint16_t>(std::min(det.height * factor, full_height - y));
+        det.x = static_cast<uint16_t>(x);
+        det.y = static_cast<uint16_t>(y);
+    }
+}
+
+bool readFileBytes(const std::string& path, std::vector<uint8_t>& data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        std::cerr << "Cannot open file: " << path << std::endl;
+        return false;
+    }
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    data.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(reinterpret_cast<char*>(data.data()), size))
+    {
+        std::cerr << "Failed to read file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,193 @@
+#include "rknn_cpp/utils/layer_profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace rknn_cpp
+{
+
+static std::vector<std::string> splitWhitespace(const std::string& line)
+{
+    std::vector<std::string> tokens;
+    std::istringstream ss(line);
+    std::string token;
+    while (ss >> token)
+    {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+static int findColumn(const std::vector<std::string>& header, const std::vector<std::string>& names)
+{
+    for (size_t i = 0; i < header.size(); i++)
+    {
+        if (std::find(names.begin(), names.end(), header[i]) != names.end())
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+static bool isInteger(const std::string& token)
+{
+    return !token.empty() && std::all_of(token.begin(), token.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+bool parsePerfDetail(const char* text, std::vector<LayerPerf>& layers)
+{
+    layers.clear();
+    if (text == nullptr)
+    {
+        return false;
+    }
+
+    // 部分列名包含空格（如"DDR Cycles"），表头与数据行的列数不一致：
+    // 形状列之前的列按从前往后的位置取，之后的列按从后往前的位置取
+    std::istringstream stream(text);
+    std::string line;
+    bool header_found = false;
+    int col_type = -1;
+    int col_target = -1;
+    int col_time_from_end = -1;
+    size_t min_columns = 0;
+
+    while (std::getline(stream, line))
+    {
+        std::vector<std::string> tokens = splitWhitespace(line);
+        if (tokens.empty())
+        {
+            continue;
+        }
+
+        // 表头：以ID开头且包含OpType
+        if (!header_found)
+        {
+            if (tokens[0] == "ID" && std::find(tokens.begin(), tokens.end(), "OpType") != tokens.end())
+            {
+                header_found = true;
+                col_type = findColumn(tokens, {"OpType"});
+                col_target = findColumn(tokens, {"Target"});
+                int col_time = findColumn(tokens, {"Time(us)", "TimeUsage(us)"});
+                if (col_time >= 0)
+                {
+                    col_time_from_end = static_cast<int>(tokens.size()) - 1 - col_time;
+                }
+                min_columns = static_cast<size_t>(std::max({col_type, col_target, col_time_from_end}) + 2);
+            }
+            continue;
+        }
+
+        // 数据行：首列为序号；其他行（分隔线、汇总）跳过
+        if (!isInteger(tokens[0]) || tokens.size() < min_columns)
+        {
+            continue;
+        }
+
+        LayerPerf layer;
+        layer.id = std::stoi(tokens[0]);
+        layer.op_type = col_type >= 0 ? tokens[col_type] : "";
+        layer.target = col_target >= 0 ? tokens[col_target] : "";
+        if (col_time_from_end >= 0)
+        {
+            const std::string& time = tokens[tokens.size() - 1 - col_time_from_end];
+            if (isInteger(time))
+            {
+                layer.time_us = static_cast<uint32_t>(std::stoul(time));
+            }
+        }
+        layer.name = tokens.back();
+        layers.push_back(std::move(layer));
+    }
+
+    return !layers.empty();
+}
+
+void LayerProfiler::accumulate(const std::vector<LayerPerf>& layers)
+{
+    for (const auto& layer : layers)
+    {
+        // 全名为空时用序号区分
+        const std::string key = layer.name.empty() ? std::to_string(layer.id) : layer.name;
+        auto it = index_.find(key);
+        if (it == index_.end())
+        {
+            LayerProfile profile;
+            profile.id = layer.id;
+            profile.name = layer.name;
+            profile.op_type = layer.op_type;
+            profile.target = layer.target;
+            profile.min_us = layer.time_us;
+            profile.max_us = layer.time_us;
+            it = index_.emplace(key, layers_.size()).first;
+            layers_.push_back(std::move(profile));
+        }
+
+        LayerProfile& profile = layers_[it->second];
+        profile.runs++;
+        profile.total_us += layer.time_us;
+        profile.min_us = std::min(profile.min_us, static_cast<double>(layer.time_us));
+        profile.max_us = std::max(profile.max_us, static_cast<double>(layer.time_us));
+    }
+    if (!layers.empty())
+    {
+        runs_++;
+    }
+}
+
+void LayerProfiler::reset()
+{
+    layers_.clear();
+    index_.clear();
+    runs_ = 0;
+}
+
+std::vector<LayerProfile> LayerProfiler::profile() const
+{
+    std::vector<LayerProfile> sorted = layers_;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const LayerProfile& a, const LayerProfile& b) { return a.total_us > b.total_us; });
+    return sorted;
+}
+
+std::string LayerProfiler::formatTable(const std::vector<LayerProfile>& profile, size_t top_n)
+{
+    double total = 0.0;
+    std::map<std::string, double> per_target;
+    for (const auto& layer : profile)
+    {
+        total += layer.avgUs();
+        per_target[layer.target] += layer.avgUs();
+    }
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << std::left << std::setw(6) << "ID" << std::setw(20) << "OpType" << std::setw(8) << "Target" << std::right
+        << std::setw(10) << "Avg(us)" << std::setw(10) << "Min(us)" << std::setw(10) << "Max(us)" << std::setw(8)
+        << "%" << "  Name" << std::endl;
+    out << std::string(100, '-') << std::endl;
+
+    size_t count = top_n > 0 ? std::min(top_n, profile.size()) : profile.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto& layer = profile[i];
+        double percent = total > 0.0 ? layer.avgUs() * 100.0 / total : 0.0;
+        out << std::left << std::setw(6) << layer.id << std::setw(20) << layer.op_type << std::setw(8) << layer.target
+            << std::right << std::setw(10) << layer.avgUs() << std::setw(10) << layer.min_us << std::setw(10)
+            << layer.max_us << std::setw(8) << percent << "  " << layer.name << std::endl;
+    }
+    out << std::string(100, '-') << std::endl;
+
+    out << "Total per frame: " << total << " us (" << profile.size() << " layers)" << std::endl;
+    for (const auto& entry : per_target)
+    {
+        double percent = total > 0.0 ? entry.second * 100.0 / total : 0.0;
+        out << "  " << std::left << std::setw(8) << (entry.first.empty() ? "?" : entry.first) << std::right
+            << std::setw(10) << entry.second << " us  " << std::setw(5) << percent << "%" << std::endl;
+    }
+    return out.str();
+}
+
+}  // namespace rknn_cpp
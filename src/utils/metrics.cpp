@@ -0,0 +1,322 @@
+#include "rknn_cpp/utils/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+// 延迟分桶（毫秒），覆盖从轻量预处理到冷启动推理的范围
+static const std::vector<double> kLatencyBucketsMs = {0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+static const std::vector<double> kCountBuckets = {0, 1, 2, 5, 10, 20, 50, 100};
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds)), buckets_(new std::atomic<uint64_t>[bounds_.size() + 1])
+{
+    for (size_t i = 0; i <= bounds_.size(); i++)
+    {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value)
+{
+    size_t index = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+    buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_milli_.fetch_add(static_cast<int64_t>(std::llround(value * 1000.0)), std::memory_order_relaxed);
+}
+
+double Histogram::sum() const
+{
+    return static_cast<double>(sum_milli_.load(std::memory_order_relaxed)) / 1000.0;
+}
+
+ModelMetrics::ModelMetrics(const std::string& name)
+    : model_name(name),
+      detections_per_frame(kCountBuckets),
+      preprocess_ms(kLatencyBucketsMs),
+      inference_ms(kLatencyBucketsMs),
+      postprocess_ms(kLatencyBucketsMs),
+      total_ms(kLatencyBucketsMs)
+{
+}
+
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    stopHttpServer();
+}
+
+ModelMetrics* MetricsRegistry::getModelMetrics(const std::string& model_name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& metrics = models_[model_name];
+    if (!metrics)
+    {
+        metrics = std::make_unique<ModelMetrics>(model_name);
+    }
+    return metrics.get();
+}
+
+std::atomic<uint64_t>* MetricsRegistry::getCounter(const std::string& name, const std::string& help,
+                                                   const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CounterFamily& family = counters_[name];
+    if (family.help.empty())
+    {
+        family.help = help;
+    }
+    auto& counter = family.series[labels];
+    if (!counter)
+    {
+        counter = std::make_unique<std::atomic<uint64_t>>(0);
+    }
+    return counter.get();
+}
+
+std::string MetricsRegistry::escapeLabelValue(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value)
+    {
+        if (c == '\\' || c == '"')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (c == '\n')
+        {
+            escaped += "\\n";
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+static std::string formatValue(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.17g", value);
+    return buf;
+}
+
+static void renderHistogram(std::ostringstream& out, const std::string& name, const std::string& label,
+                            const Histogram& histogram)
+{
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < histogram.bounds().size(); i++)
+    {
+        cumulative += histogram.bucketCount(i);
+        out << name << "_bucket{" << label << ",le=\"" << formatValue(histogram.bounds()[i]) << "\"} " << cumulative
+            << "\n";
+    }
+    cumulative += histogram.bucketCount(histogram.bounds().size());
+    out << name << "_bucket{" << label << ",le=\"+Inf\"} " << cumulative << "\n";
+    out << name << "_sum{" << label << "} " << formatValue(histogram.sum()) << "\n";
+    out << name << "_count{" << label << "} " << histogram.count() << "\n";
+}
+
+std::string MetricsRegistry::renderPrometheus() const
+{
+    std::vector<const ModelMetrics*> models;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : models_)
+        {
+            models.push_back(entry.second.get());
+        }
+    }
+
+    std::ostringstream out;
+    auto label_of = [](const ModelMetrics* m) { return "model=\"" + escapeLabelValue(m->model_name) + "\""; };
+
+    out << "# HELP rknn_frames_total Frames processed successfully.\n# TYPE rknn_frames_total counter\n";
+    for (const auto* m : models)
+    {
+        out << "rknn_frames_total{" << label_of(m) << "} " << m->frames_total.load(std::memory_order_relaxed) << "\n";
+    }
+    out << "# HELP rknn_failures_total Failed predictions.\n# TYPE rknn_failures_total counter\n";
+    for (const auto* m : models)
+    {
+        out << "rknn_failures_total{" << label_of(m) << "} " << m->failures_total.load(std::memory_order_relaxed)
+            << "\n";
+    }
+    out << "# HELP rknn_detections_total Detections or classifications returned.\n"
+        << "# TYPE rknn_detections_total counter\n";
+    for (const auto* m : models)
+    {
+        out << "rknn_detections_total{" << label_of(m) << "} " << m->detections_total.load(std::memory_order_relaxed)
+            << "\n";
+    }
+
+    struct HistogramInfo
+    {
+        const char* name;
+        const char* help;
+        const Histogram ModelMetrics::*member;
+    };
+    static const HistogramInfo histograms[] = {
+        {"rknn_detections_per_frame", "Results per frame.", &ModelMetrics::detections_per_frame},
+        {"rknn_preprocess_latency_ms", "Preprocessing latency in milliseconds.", &ModelMetrics::preprocess_ms},
+        {"rknn_inference_latency_ms", "NPU inference latency in milliseconds.", &ModelMetrics::inference_ms},
+        {"rknn_postprocess_latency_ms", "Postprocessing latency in milliseconds.", &ModelMetrics::postprocess_ms},
+        {"rknn_total_latency_ms", "End-to-end predict latency in milliseconds.", &ModelMetrics::total_ms},
+    };
+    for (const auto& info : histograms)
+    {
+        out << "# HELP " << info.name << " " << info.help << "\n# TYPE " << info.name << " histogram\n";
+        for (const auto* m : models)
+        {
+            renderHistogram(out, info.name, label_of(m), m->*(info.member));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& family : counters_)
+    {
+        out << "# HELP " << family.first << " " << family.second.help << "\n# TYPE " << family.first
+            << " counter\n";
+        for (const auto& series : family.second.series)
+        {
+            out << family.first << "{" << series.first << "} " << series.second->load(std::memory_order_relaxed)
+                << "\n";
+        }
+    }
+    return out.str();
+}
+
+bool MetricsRegistry::writeToFile(const std::string& path) const
+{
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "Cannot open metrics file: " << tmp_path << std::endl;
+            return false;
+        }
+        file << renderPrometheus();
+        if (!file.good())
+        {
+            return false;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "Failed to rename metrics file to " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MetricsRegistry::startHttpServer(int port)
+{
+    if (http_running_.load())
+    {
+        return true;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        std::cerr << "Metrics HTTP: socket() failed" << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // 仅本机访问
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, 4) < 0)
+    {
+        std::cerr << "Metrics HTTP: cannot listen on 127.0.0.1:" << port << std::endl;
+        close(fd);
+        return false;
+    }
+
+    http_fd_ = fd;
+    http_running_.store(true);
+    http_thread_ = std::thread(&MetricsRegistry::serveHttp, this, fd);
+    std::cout << "[METRICS] Serving http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsRegistry::stopHttpServer()
+{
+    if (!http_running_.exchange(false))
+    {
+        return;
+    }
+    if (http_thread_.joinable())
+    {
+        http_thread_.join();
+    }
+    close(http_fd_);
+    http_fd_ = -1;
+}
+
+void MetricsRegistry::serveHttp(int listen_fd)
+{
+    while (http_running_.load())
+    {
+        // 带超时等待连接，便于stopHttpServer及时退出
+        pollfd pfd = {listen_fd, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0)
+        {
+            continue;
+        }
+        int client = accept(listen_fd, nullptr, nullptr);
+        if (client < 0)
+        {
+            continue;
+        }
+
+        // 读取请求头（内容不做解析，任何路径都返回指标）
+        char request[1024];
+        pollfd cfd = {client, POLLIN, 0};
+        if (poll(&cfd, 1, 1000) > 0)
+        {
+            (void)recv(client, request, sizeof(request), 0);
+        }
+
+        std::string body = renderPrometheus();
+        std::string response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                               std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+        size_t sent = 0;
+        while (sent < response.size())
+        {
+            ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                break;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        close(client);
+    }
+}
+
+}  // namespace rknn_cpp
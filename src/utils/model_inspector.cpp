@@ -0,0 +1,394 @@
+#include "rknn_cpp/utils/model_inspector.h"
+#include "rknn_api.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+static const char* kCacheMagic = "rknn_cpp_model_info";
+static const int kCacheVersion = 1;
+
+// ===== 旁路缓存 =====
+// 文本格式，每行一个字段；可能含空格的字符串放在行尾，换行和反斜杠转义
+
+static std::string escapeLine(const std::string& value)
+{
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value)
+    {
+        if (c == '\\')
+        {
+            out += "\\\\";
+        }
+        else if (c == '\n')
+        {
+            out += "\\n";
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    return out;
+}
+
+static std::string unescapeLine(const std::string& value)
+{
+    std::string out;
+    out.reserve(value.size());
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        if (value[i] == '\\' && i + 1 < value.size())
+        {
+            out += value[++i] == 'n' ? '\n' : value[i];
+        }
+        else
+        {
+            out += value[i];
+        }
+    }
+    return out;
+}
+
+static std::string readRest(std::istringstream& stream)
+{
+    std::string rest;
+    std::getline(stream >> std::ws, rest);
+    return unescapeLine(rest);
+}
+
+static void writeTensor(std::ostream& out, const char* tag, const TensorInfo& tensor)
+{
+    out << tag << " " << tensor.index << " " << tensor.format << " " << tensor.type << " " << tensor.qnt_type << " "
+        << tensor.zero_point << " " << std::setprecision(9) << tensor.scale << " " << tensor.n_elems << " "
+        << tensor.size << " " << tensor.dims.size();
+    for (uint32_t dim : tensor.dims)
+    {
+        out << " " << dim;
+    }
+    out << " " << escapeLine(tensor.name) << "\n";
+}
+
+static bool readTensor(std::istringstream& stream, TensorInfo& tensor)
+{
+    size_t n_dims = 0;
+    stream >> tensor.index >> tensor.format >> tensor.type >> tensor.qnt_type >> tensor.zero_point >> tensor.scale >>
+        tensor.n_elems >> tensor.size >> n_dims;
+    if (!stream || n_dims > RKNN_MAX_DIMS)
+    {
+        return false;
+    }
+    tensor.dims.resize(n_dims);
+    for (auto& dim : tensor.dims)
+    {
+        stream >> dim;
+    }
+    tensor.name = readRest(stream);
+    return static_cast<bool>(stream) || stream.eof();
+}
+
+static std::string cachePath(const std::string& path)
+{
+    return path + ".info";
+}
+
+static bool loadCache(const std::string& path, uint64_t file_size, int64_t file_mtime, ModelInfo& info)
+{
+    std::ifstream file(cachePath(path));
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    std::string magic;
+    int version = 0;
+    if (!std::getline(file, line) || !(std::istringstream(line) >> magic >> version) || magic != kCacheMagic ||
+        version != kCacheVersion)
+    {
+        return false;
+    }
+
+    ModelInfo cached;
+    cached.path = path;
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        std::string key;
+        stream >> key;
+        if (key == "file_size")
+        {
+            stream >> cached.file_size;
+        }
+        else if (key == "file_mtime")
+        {
+            stream >> cached.file_mtime;
+        }
+        else if (key == "weight_bytes")
+        {
+            stream >> cached.weight_bytes;
+        }
+        else if (key == "internal_bytes")
+        {
+            stream >> cached.internal_bytes;
+        }
+        else if (key == "api_version")
+        {
+            cached.api_version = readRest(stream);
+        }
+        else if (key == "driver_version")
+        {
+            cached.driver_version = readRest(stream);
+        }
+        else if (key == "custom_string")
+        {
+            cached.custom_string = readRest(stream);
+        }
+        else if (key == "input" || key == "output")
+        {
+            TensorInfo tensor;
+            if (!readTensor(stream, tensor))
+            {
+                return false;
+            }
+            (key == "input" ? cached.inputs : cached.outputs).push_back(tensor);
+        }
+    }
+
+    // 模型文件已变化则缓存失效
+    if (cached.file_size != file_size || cached.file_mtime != file_mtime || cached.inputs.empty())
+    {
+        return false;
+    }
+    cached.valid = true;
+    cached.from_cache = true;
+    info = std::move(cached);
+    return true;
+}
+
+static void writeCache(std::ostream& file, const ModelInfo& info)
+{
+    file << kCacheMagic << " " << kCacheVersion << "\n";
+    file << "file_size " << info.file_size << "\n";
+    file << "file_mtime " << info.file_mtime << "\n";
+    file << "weight_bytes " << info.weight_bytes << "\n";
+    file << "internal_bytes " << info.internal_bytes << "\n";
+    file << "api_version " << escapeLine(info.api_version) << "\n";
+    file << "driver_version " << escapeLine(info.driver_version) << "\n";
+    file << "custom_string " << escapeLine(info.custom_string) << "\n";
+    for (const auto& tensor : info.inputs)
+    {
+        writeTensor(file, "input", tensor);
+    }
+    for (const auto& tensor : info.outputs)
+    {
+        writeTensor(file, "output", tensor);
+    }
+}
+
+static void saveCache(const ModelInfo& info)
+{
+    // 先写临时文件再rename，其他进程同时inspectModel时不会读到写了一半的缓存；
+    // 临时文件名带pid，多个进程同时写入互不干扰
+    std::string path = cachePath(info.path);
+    std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            return;  // 只读目录等情况下不缓存
+        }
+        writeCache(file, info);
+        file.close();
+        if (!file)
+        {
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec)
+    {
+        std::remove(tmp_path.c_str());
+    }
+}
+
+// ===== 查询 =====
+
+static TensorInfo toTensorInfo(const rknn_tensor_attr& attr)
+{
+    TensorInfo tensor;
+    tensor.index = static_cast<int>(attr.index);
+    tensor.name = attr.name;
+    tensor.dims.assign(attr.dims, attr.dims + attr.n_dims);
+    tensor.format = get_format_string(attr.fmt);
+    tensor.type = get_type_string(attr.type);
+    tensor.qnt_type = get_qnt_type_string(attr.qnt_type);
+    tensor.zero_point = attr.zp;
+    tensor.scale = attr.scale;
+    tensor.n_elems = attr.n_elems;
+    tensor.size = attr.size;
+    return tensor;
+}
+
+static bool queryModelInfo(const std::string& path, ModelInfo& info)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        std::cerr << "Cannot open model file: " << path << std::endl;
+        return false;
+    }
+    size_t model_size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::vector<char> model_data(model_size);
+    if (!file.read(model_data.data(), model_size))
+    {
+        std::cerr << "Failed to read model file: " << path << std::endl;
+        return false;
+    }
+
+    // 仅收集模型信息，不分配权重和中间层内存
+    rknn_context ctx = 0;
+    int ret = rknn_init(&ctx, model_data.data(), model_size, RKNN_FLAG_COLLECT_MODEL_INFO_ONLY, nullptr);
+    if (ret < 0)
+    {
+        std::cerr << "rknn_init (model info only) failed! ret=" << ret << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    rknn_input_output_num io_num;
+    memset(&io_num, 0, sizeof(io_num));
+    ret = rknn_query(ctx, RKNN_QUERY_IN_OUT_NUM, &io_num, sizeof(io_num));
+    if (ret != RKNN_SUCC)
+    {
+        std::cerr << "rknn_query RKNN_QUERY_IN_OUT_NUM failed! ret=" << ret << std::endl;
+        ok = false;
+    }
+    for (uint32_t i = 0; ok && i < io_num.n_input + io_num.n_output; i++)
+    {
+        bool is_input = i < io_num.n_input;
+        rknn_tensor_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.index = is_input ? i : i - io_num.n_input;
+        ret = rknn_query(ctx, is_input ? RKNN_QUERY_INPUT_ATTR : RKNN_QUERY_OUTPUT_ATTR, &attr, sizeof(attr));
+        if (ret != RKNN_SUCC)
+        {
+            std::cerr << "rknn_query tensor attr failed! ret=" << ret << std::endl;
+            ok = false;
+            break;
+        }
+        (is_input ? info.inputs : info.outputs).push_back(toTensorInfo(attr));
+    }
+
+    // 以下信息在部分驱动版本上不可用，查询失败时留空
+    rknn_sdk_version version;
+    memset(&version, 0, sizeof(version));
+    if (ok && rknn_query(ctx, RKNN_QUERY_SDK_VERSION, &version, sizeof(version)) == RKNN_SUCC)
+    {
+        info.api_version = version.api_version;
+        info.driver_version = version.drv_version;
+    }
+    rknn_custom_string custom;
+    memset(&custom, 0, sizeof(custom));
+    if (ok && rknn_query(ctx, RKNN_QUERY_CUSTOM_STRING, &custom, sizeof(custom)) == RKNN_SUCC)
+    {
+        info.custom_string = std::string(custom.string, strnlen(custom.string, sizeof(custom.string)));
+    }
+    rknn_mem_size mem_size;
+    memset(&mem_size, 0, sizeof(mem_size));
+    if (ok && rknn_query(ctx, RKNN_QUERY_MEM_SIZE, &mem_size, sizeof(mem_size)) == RKNN_SUCC)
+    {
+        info.weight_bytes = mem_size.total_weight_size;
+        info.internal_bytes = mem_size.total_internal_size;
+    }
+
+    rknn_destroy(ctx);
+    return ok;
+}
+
+ModelInfo inspectModel(const std::string& path, bool use_cache)
+{
+    ModelInfo info;
+    info.path = path;
+
+    std::error_code ec;
+    uintmax_t file_size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        std::cerr << "Cannot stat model file: " << path << std::endl;
+        return info;
+    }
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    info.file_size = static_cast<uint64_t>(file_size);
+    info.file_mtime = ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
+
+    if (use_cache && loadCache(path, info.file_size, info.file_mtime, info))
+    {
+        return info;
+    }
+    if (!queryModelInfo(path, info))
+    {
+        return info;
+    }
+    info.valid = true;
+    saveCache(info);
+    return info;
+}
+
+static void printTensor(const TensorInfo& tensor)
+{
+    std::cout << "  [" << tensor.index << "] " << tensor.name << " dims=[";
+    for (size_t i = 0; i < tensor.dims.size(); i++)
+    {
+        std::cout << (i > 0 ? ", " : "") << tensor.dims[i];
+    }
+    std::cout << "] " << tensor.format << " " << tensor.type << " size=" << tensor.size << " qnt=" << tensor.qnt_type
+              << " zp=" << tensor.zero_point << " scale=" << tensor.scale << std::endl;
+}
+
+void printModelInfo(const ModelInfo& info)
+{
+    if (!info.valid)
+    {
+        std::cout << "[MODEL] " << info.path << ": unavailable" << std::endl;
+        return;
+    }
+    std::cout << "[MODEL] " << info.path << (info.from_cache ? " (cached)" : "") << std::endl;
+    std::cout << "  File size     : " << info.file_size << " bytes" << std::endl;
+    if (!info.api_version.empty())
+    {
+        std::cout << "  SDK version   : " << info.api_version << " (driver " << info.driver_version << ")"
+                  << std::endl;
+    }
+    if (!info.custom_string.empty())
+    {
+        std::cout << "  Custom string : " << info.custom_string << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Memory        : " << info.estimatedBytes() / 1048576.0 << " MB (weight "
+              << info.weight_bytes / 1048576.0 << ", internal " << info.internal_bytes / 1048576.0 << ", io "
+              << info.ioBytes() / 1048576.0 << ")" << std::defaultfloat << std::endl;
+    std::cout << "  Inputs (" << info.inputs.size() << "):" << std::endl;
+    for (const auto& tensor : info.inputs)
+    {
+        printTensor(tensor);
+    }
+    std::cout << "  Outputs (" << info.outputs.size() << "):" << std::endl;
+    for (const auto& tensor : info.outputs)
+    {
+        printTensor(tensor);
+    }
+}
+
+}  // namespace rknn_cpp
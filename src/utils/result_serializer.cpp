@@ -0,0 +1,534 @@
+#include "rknn_cpp/utils/result_serializer.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+static const char kBinaryMagic[4] = {'R', 'K', 'R', '1'};
+static const uint16_t kBinaryVersion = 1;
+static const size_t kBinaryHeaderSize = 48;
+static const size_t kDetectionEntrySize = 20;
+static const size_t kClassificationEntrySize = 8;
+
+enum BinaryKind : uint8_t
+{
+    KIND_NONE = 0,
+    KIND_DETECTION = 1,
+    KIND_CLASSIFICATION = 2,
+};
+
+// ===== 缓冲区写入 =====
+// 溢出后不再写入，最终由调用方根据ok()决定返回0
+
+class Cursor
+{
+   public:
+    Cursor(char* buffer, size_t capacity) : begin_(buffer), pos_(buffer), end_(buffer + capacity), ok_(true) {}
+
+    void put(char c)
+    {
+        if (pos_ < end_)
+        {
+            *pos_++ = c;
+        }
+        else
+        {
+            ok_ = false;
+        }
+    }
+
+    void put(std::string_view text)
+    {
+        if (text.empty())
+        {
+            return;
+        }
+        if (static_cast<size_t>(end_ - pos_) >= text.size())
+        {
+            memcpy(pos_, text.data(), text.size());
+            pos_ += text.size();
+        }
+        else
+        {
+            ok_ = false;
+        }
+    }
+
+    template <typename T>
+    void putInt(T value)
+    {
+        auto res = std::to_chars(pos_, end_, value);
+        if (res.ec == std::errc())
+        {
+            pos_ = res.ptr;
+        }
+        else
+        {
+            ok_ = false;
+        }
+    }
+
+    // JSON不支持nan/inf，非有限值写为null
+    void putFloat(float value, int precision)
+    {
+        if (!std::isfinite(value))
+        {
+            put("null");
+            return;
+        }
+        auto res = std::to_chars(pos_, end_, value, std::chars_format::fixed, precision);
+        if (res.ec == std::errc())
+        {
+            pos_ = res.ptr;
+        }
+        else
+        {
+            ok_ = false;
+        }
+    }
+
+    void putJsonString(std::string_view text)
+    {
+        static const char kHex[] = "0123456789abcdef";
+        put('"');
+        for (char ch : text)
+        {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (c == '"' || c == '\\')
+            {
+                put('\\');
+                put(ch);
+            }
+            else if (c < 0x20)
+            {
+                put("\\u00");
+                put(kHex[c >> 4]);
+                put(kHex[c & 0xF]);
+            }
+            else
+            {
+                put(ch);
+            }
+        }
+        put('"');
+    }
+
+    template <typename T>
+    void putRaw(T value)
+    {
+        if (static_cast<size_t>(end_ - pos_) >= sizeof(T))
+        {
+            memcpy(pos_, &value, sizeof(T));
+            pos_ += sizeof(T);
+        }
+        else
+        {
+            ok_ = false;
+        }
+    }
+
+    bool ok() const { return ok_; }
+    size_t size() const { return ok_ ? static_cast<size_t>(pos_ - begin_) : 0; }
+
+   private:
+    char* begin_;
+    char* pos_;
+    char* end_;
+    bool ok_;
+};
+
+// ===== JSON =====
+
+static void putClassificationsJson(Cursor& out, const ClassificationResults& classifications)
+{
+    out.put('[');
+    for (size_t i = 0; i < classifications.size(); i++)
+    {
+        const auto& cls = classifications[i];
+        out.put(i > 0 ? ",{\"class_id\":" : "{\"class_id\":");
+        out.putInt(static_cast<int>(cls.class_id));
+        out.put(",\"class_name\":");
+        out.putJsonString(cls.class_name);
+        out.put(",\"confidence\":");
+        out.putFloat(cls.confidence, 4);
+        out.put('}');
+    }
+    out.put(']');
+}
+
+size_t serializeJson(const InferenceResult& result, const ResultRecordInfo& info, char* buffer, size_t capacity)
+{
+    Cursor out(buffer, capacity);
+    out.put("{\"index\":");
+    out.putInt(info.index);
+    if (info.timestamp_us != 0)
+    {
+        out.put(",\"timestamp_us\":");
+        out.putInt(info.timestamp_us);
+    }
+    if (!info.source.empty())
+    {
+        out.put(",\"source\":");
+        out.putJsonString(info.source);
+    }
+    out.put(result.is_success ? ",\"success\":true" : ",\"success\":false");
+    if (!info.error.empty())
+    {
+        out.put(",\"error\":");
+        out.putJsonString(info.error);
+    }
+    out.put(",\"inference_ms\":");
+    out.putFloat(result.inference_time, 3);
+    out.put(",\"total_ms\":");
+    out.putFloat(result.total_time, 3);
+
+    if (const auto* detections = std::any_cast<DetectionResults>(&result.result_data))
+    {
+        out.put(",\"detections\":[");
+        for (size_t i = 0; i < detections->size(); i++)
+        {
+            const auto& det = (*detections)[i];
+            out.put(i > 0 ? ",{\"class_id\":" : "{\"class_id\":");
+            out.putInt(det.class_id);
+            out.put(",\"class_name\":");
+            out.putJsonString(det.class_name);
+            out.put(",\"confidence\":");
+            out.putFloat(det.confidence, 4);
+            out.put(",\"box\":[");
+            out.putInt(det.x);
+            out.put(',');
+            out.putInt(det.y);
+            out.put(',');
+            out.putInt(det.width);
+            out.put(',');
+            out.putInt(det.height);
+            out.put(']');
+            if (det.track_id >= 0)
+            {
+                out.put(",\"track_id\":");
+                out.putInt(det.track_id);
+            }
+            // 级联分类结果（DetectorClassifierCascade）
+            if (!det.classifications.empty())
+            {
+                out.put(",\"classifications\":");
+                putClassificationsJson(out, det.classifications);
+            }
+            out.put('}');
+        }
+        out.put(']');
+    }
+    else if (const auto* classifications = std::any_cast<ClassificationResults>(&result.result_data))
+    {
+        out.put(",\"classifications\":");
+        putClassificationsJson(out, *classifications);
+    }
+    out.put("}\n");
+    return out.size();
+}
+
+// ===== 二进制 =====
+
+static size_t alignUp4(size_t size)
+{
+    return (size + 3) & ~static_cast<size_t>(3);
+}
+
+size_t binaryRecordSize(const InferenceResult& result, const ResultRecordInfo& info)
+{
+    size_t size = kBinaryHeaderSize + alignUp4(info.source.size());
+    if (const auto* detections = std::any_cast<DetectionResults>(&result.result_data))
+    {
+        size += detections->size() * kDetectionEntrySize;
+        for (const auto& det : *detections)
+        {
+            size += det.classifications.size() * kClassificationEntrySize;
+        }
+    }
+    else if (const auto* classifications = std::any_cast<ClassificationResults>(&result.result_data))
+    {
+        size += classifications->size() * kClassificationEntrySize;
+    }
+    return size;
+}
+
+size_t serializeBinary(const InferenceResult& result, const ResultRecordInfo& info, char* buffer, size_t capacity)
+{
+    const size_t record_size = binaryRecordSize(result, info);
+    if (record_size > capacity)
+    {
+        return 0;
+    }
+
+    const auto* detections = std::any_cast<DetectionResults>(&result.result_data);
+    const auto* classifications = std::any_cast<ClassificationResults>(&result.result_data);
+    uint8_t kind = detections != nullptr        ? KIND_DETECTION
+                   : classifications != nullptr ? KIND_CLASSIFICATION
+                                                : KIND_NONE;
+    uint32_t count = static_cast<uint32_t>(detections != nullptr        ? detections->size()
+                                           : classifications != nullptr ? classifications->size()
+                                                                        : 0);
+
+    Cursor out(buffer, capacity);
+    out.put(std::string_view(kBinaryMagic, sizeof(kBinaryMagic)));
+    out.putRaw<uint16_t>(kBinaryVersion);
+    out.putRaw<uint8_t>(kind);
+    out.putRaw<uint8_t>(result.is_success ? 1 : 0);
+    out.putRaw<uint32_t>(static_cast<uint32_t>(record_size));
+    out.putRaw<uint32_t>(count);
+    out.putRaw<uint64_t>(info.index);
+    out.putRaw<int64_t>(info.timestamp_us);
+    out.putRaw<float>(result.inference_time);
+    out.putRaw<float>(result.total_time);
+    out.putRaw<uint32_t>(static_cast<uint32_t>(info.source.size()));
+    out.putRaw<uint32_t>(0);
+    out.put(info.source);
+    for (size_t i = info.source.size(); i < alignUp4(info.source.size()); i++)
+    {
+        out.put('\0');
+    }
+
+    if (detections != nullptr)
+    {
+        for (const auto& det : *detections)
+        {
+            out.putRaw<uint16_t>(det.x);
+            out.putRaw<uint16_t>(det.y);
+            out.putRaw<uint16_t>(det.width);
+            out.putRaw<uint16_t>(det.height);
+            out.putRaw<uint16_t>(det.class_id);
+            out.putRaw<uint16_t>(static_cast<uint16_t>(det.classifications.size()));
+            out.putRaw<float>(det.confidence);
+            out.putRaw<int32_t>(det.track_id);
+        }
+        // 级联分类条目按检测顺序排在全部检测条目之后
+        for (const auto& det : *detections)
+        {
+            for (const auto& cls : det.classifications)
+            {
+                out.putRaw<uint16_t>(cls.class_id);
+                out.putRaw<uint16_t>(0);
+                out.putRaw<float>(cls.confidence);
+            }
+        }
+    }
+    else if (classifications != nullptr)
+    {
+        for (const auto& cls : *classifications)
+        {
+            out.putRaw<uint16_t>(cls.class_id);
+            out.putRaw<uint16_t>(0);
+            out.putRaw<float>(cls.confidence);
+        }
+    }
+    return out.size();
+}
+
+template <typename T>
+static T readRaw(const char* data)
+{
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+bool decodeBinaryRecord(const char* data, size_t size, BinaryResultRecord& record, size_t& consumed)
+{
+    if (size < kBinaryHeaderSize || memcmp(data, kBinaryMagic, sizeof(kBinaryMagic)) != 0 ||
+        readRaw<uint16_t>(data + 4) != kBinaryVersion)
+    {
+        return false;
+    }
+    uint8_t kind = readRaw<uint8_t>(data + 6);
+    uint8_t flags = readRaw<uint8_t>(data + 7);
+    uint32_t record_size = readRaw<uint32_t>(data + 8);
+    uint32_t count = readRaw<uint32_t>(data + 12);
+    uint32_t source_len = readRaw<uint32_t>(data + 40);
+
+    size_t entry_size = kind == KIND_DETECTION        ? kDetectionEntrySize
+                        : kind == KIND_CLASSIFICATION ? kClassificationEntrySize
+                                                      : 0;
+    size_t entries_offset = kBinaryHeaderSize + alignUp4(source_len);
+    size_t expected = entries_offset + static_cast<size_t>(count) * entry_size;
+    if (kind > KIND_CLASSIFICATION || expected > size)
+    {
+        return false;
+    }
+    // 检测条目之后的级联分类条目
+    size_t nested_count = 0;
+    if (kind == KIND_DETECTION)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            nested_count += readRaw<uint16_t>(data + entries_offset + i * kDetectionEntrySize + 10);
+        }
+        expected += nested_count * kClassificationEntrySize;
+    }
+    if (record_size != expected || record_size > size)
+    {
+        return false;
+    }
+
+    record.index = readRaw<uint64_t>(data + 16);
+    record.timestamp_us = readRaw<int64_t>(data + 24);
+    record.inference_ms = readRaw<float>(data + 32);
+    record.total_ms = readRaw<float>(data + 36);
+    record.success = (flags & 1) != 0;
+    record.source.assign(data + kBinaryHeaderSize, source_len);
+    record.detections.clear();
+    record.classifications.clear();
+
+    auto readClassification = [](const char* entry) {
+        ClassificationResult cls;
+        cls.class_id = static_cast<uint8_t>(readRaw<uint16_t>(entry));
+        cls.confidence = readRaw<float>(entry + 4);
+        return cls;
+    };
+
+    const char* entry = data + entries_offset;
+    const char* nested = entry + static_cast<size_t>(count) * entry_size;
+    for (uint32_t i = 0; i < count; i++, entry += entry_size)
+    {
+        if (kind == KIND_DETECTION)
+        {
+            DetectionResult det;
+            det.x = readRaw<uint16_t>(entry);
+            det.y = readRaw<uint16_t>(entry + 2);
+            det.width = readRaw<uint16_t>(entry + 4);
+            det.height = readRaw<uint16_t>(entry + 6);
+            det.class_id = readRaw<uint16_t>(entry + 8);
+            det.confidence = readRaw<float>(entry + 12);
+            det.track_id = readRaw<int32_t>(entry + 16);
+            uint16_t cls_count = readRaw<uint16_t>(entry + 10);
+            for (uint16_t k = 0; k < cls_count; k++, nested += kClassificationEntrySize)
+            {
+                det.classifications.push_back(readClassification(nested));
+            }
+            record.detections.push_back(det);
+        }
+        else
+        {
+            record.classifications.push_back(readClassification(entry));
+        }
+    }
+    consumed = record_size;
+    return true;
+}
+
+// ===== ResultStreamWriter =====
+
+ResultStreamWriter::ResultStreamWriter(int fd, ResultFormat format, size_t buffer_size)
+    : fd_(fd), own_fd_(false), format_(format), buffer_(std::max<size_t>(buffer_size, 4096)), used_(0),
+      file_offset_(0)
+{
+}
+
+ResultStreamWriter::ResultStreamWriter(ResultFormat format, size_t buffer_size)
+    : ResultStreamWriter(-1, format, buffer_size)
+{
+}
+
+ResultStreamWriter::~ResultStreamWriter()
+{
+    close();
+}
+
+bool ResultStreamWriter::open(const std::string& path, bool append)
+{
+    close();
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+    fd_ = ::open(path.c_str(), flags, 0644);
+    if (fd_ < 0)
+    {
+        std::cerr << "Cannot open output file: " << path << " (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    own_fd_ = true;
+    off_t end = lseek(fd_, 0, SEEK_END);
+    file_offset_ = end > 0 ? static_cast<uint64_t>(end) : 0;
+    return true;
+}
+
+void ResultStreamWriter::close()
+{
+    if (fd_ < 0)
+    {
+        return;
+    }
+    flush();
+    if (own_fd_)
+    {
+        ::close(fd_);
+    }
+    fd_ = -1;
+    own_fd_ = false;
+}
+
+size_t ResultStreamWriter::serialize(const InferenceResult& result, const ResultRecordInfo& info, char* buffer,
+                                     size_t capacity) const
+{
+    return format_ == ResultFormat::BINARY ? serializeBinary(result, info, buffer, capacity)
+                                           : serializeJson(result, info, buffer, capacity);
+}
+
+bool ResultStreamWriter::write(const InferenceResult& result, const ResultRecordInfo& info)
+{
+    if (fd_ < 0)
+    {
+        return false;
+    }
+    size_t written = serialize(result, info, buffer_.data() + used_, buffer_.size() - used_);
+    if (written == 0)
+    {
+        // 缓冲区剩余空间不足：先写出，仍放不下时扩容
+        if (!flush())
+        {
+            return false;
+        }
+        while ((written = serialize(result, info, buffer_.data(), buffer_.size())) == 0)
+        {
+            buffer_.resize(buffer_.size() * 2);
+        }
+    }
+    used_ += written;
+    return true;
+}
+
+bool ResultStreamWriter::flush()
+{
+    if (fd_ < 0)
+    {
+        return used_ == 0;
+    }
+    size_t offset = 0;
+    while (offset < used_)
+    {
+        ssize_t n = ::write(fd_, buffer_.data() + offset, used_ - offset);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            std::cerr << "Result write failed: " << strerror(errno) << std::endl;
+            // 丢弃已写出的部分，保留未写出的数据
+            memmove(buffer_.data(), buffer_.data() + offset, used_ - offset);
+            used_ -= offset;
+            file_offset_ += offset;
+            return false;
+        }
+        offset += static_cast<size_t>(n);
+    }
+    file_offset_ += used_;
+    used_ = 0;
+    return true;
+}
+
+}  // namespace rknn_cpp
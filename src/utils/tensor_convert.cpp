@@ -0,0 +1,379 @@
+#include "rknn_cpp/utils/tensor_convert.h"
+#include <algorithm>
+#include <cmath>
+
+#include "Float16.h"
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RKNN_CPP_USE_NEON 1
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#define RKNN_CPP_USE_SSE 1
+#endif
+
+namespace rknn_cpp
+{
+
+static inline int8_t saturateToInt8(float value)
+{
+    long q = lrintf(value);
+    return static_cast<int8_t>(std::min(127L, std::max(-128L, q)));
+}
+
+InputQuantParams makeInputQuantParams(int channels, const float* mean, const float* stdv, int32_t zp, float scale)
+{
+    InputQuantParams params;
+    params.channels = std::min(channels, InputQuantParams::kMaxChannels);
+    for (int c = 0; c < params.channels; c++)
+    {
+        float s = stdv[c] * scale;
+        params.mul[c] = 1.0f / s;
+        params.add[c] = -mean[c] / s + static_cast<float>(zp);
+        for (int x = 0; x < 256; x++)
+        {
+            params.lut[c][x] = saturateToInt8(x * params.mul[c] + params.add[c]);
+        }
+    }
+    return params;
+}
+
+#ifdef RKNN_CPP_USE_NEON
+// 16个uint8按同一通道系数量化为int8，舍入方式与lrintf一致（就近取偶）
+static inline int8x16_t quantize16(uint8x16_t x, float32x4_t mul, float32x4_t add)
+{
+    uint16x8_t lo = vmovl_u8(vget_low_u8(x));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(x));
+    float32x4_t f0 = vfmaq_f32(add, vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), mul);
+    float32x4_t f1 = vfmaq_f32(add, vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), mul);
+    float32x4_t f2 = vfmaq_f32(add, vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), mul);
+    float32x4_t f3 = vfmaq_f32(add, vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), mul);
+    int16x8_t s0 = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(f0)), vqmovn_s32(vcvtnq_s32_f32(f1)));
+    int16x8_t s1 = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(f2)), vqmovn_s32(vcvtnq_s32_f32(f3)));
+    return vcombine_s8(vqmovn_s16(s0), vqmovn_s16(s1));
+}
+#endif
+
+void quantizeU8ToI8NHWC(const uint8_t* src, int height, int width, const InputQuantParams& params, int dst_w_stride,
+                        int8_t* dst)
+{
+    const int channels = params.channels;
+    for (int h = 0; h < height; h++)
+    {
+        const uint8_t* src_row = src + static_cast<size_t>(h) * width * channels;
+        int8_t* dst_row = dst + static_cast<size_t>(h) * dst_w_stride * channels;
+        int w = 0;
+
+#ifdef RKNN_CPP_USE_NEON
+        if (channels == 3)
+        {
+            // 三通道交织数据：vld3解交织后按通道量化，再vst3交织写回
+            float32x4_t mul0 = vdupq_n_f32(params.mul[0]), add0 = vdupq_n_f32(params.add[0]);
+            float32x4_t mul1 = vdupq_n_f32(params.mul[1]), add1 = vdupq_n_f32(params.add[1]);
+            float32x4_t mul2 = vdupq_n_f32(params.mul[2]), add2 = vdupq_n_f32(params.add[2]);
+            for (; w + 16 <= width; w += 16)
+            {
+                uint8x16x3_t px = vld3q_u8(src_row + w * 3);
+                int8x16x3_t q;
+                q.val[0] = quantize16(px.val[0], mul0, add0);
+                q.val[1] = quantize16(px.val[1], mul1, add1);
+                q.val[2] = quantize16(px.val[2], mul2, add2);
+                vst3q_s8(dst_row + w * 3, q);
+            }
+        }
+        else if (channels == 1)
+        {
+            float32x4_t mul0 = vdupq_n_f32(params.mul[0]), add0 = vdupq_n_f32(params.add[0]);
+            for (; w + 16 <= width; w += 16)
+            {
+                vst1q_s8(dst_row + w, quantize16(vld1q_u8(src_row + w), mul0, add0));
+            }
+        }
+#endif
+
+        // 标量尾部 / 参考实现
+        for (; w < width; w++)
+        {
+            for (int c = 0; c < channels; c++)
+            {
+                dst_row[w * channels + c] = params.lut[c][src_row[w * channels + c]];
+            }
+        }
+    }
+}
+
+void quantizeU8ToI8NC1HWC2(const uint8_t* src, int height, int width, const InputQuantParams& params, int c2,
+                           int dst_w_stride, int8_t* dst)
+{
+    const int channels = params.channels;
+    const size_t plane = static_cast<size_t>(height) * dst_w_stride * c2;
+    for (int h = 0; h < height; h++)
+    {
+        const uint8_t* src_row = src + static_cast<size_t>(h) * width * channels;
+        int8_t* dst_rows[InputQuantParams::kMaxChannels];
+        for (int c = 0; c < channels; c++)
+        {
+            dst_rows[c] = dst + (c / c2) * plane + static_cast<size_t>(h) * dst_w_stride * c2 + (c % c2);
+        }
+        int w = 0;
+
+#ifdef RKNN_CPP_USE_NEON
+        // 量化与NHWC内核相同（vld3解交织后按通道量化）；目标按c2跨步且跳过填充槽位，
+        // 每16个像素先写到栈上再分散写出
+        if (channels == 3)
+        {
+            float32x4_t mul0 = vdupq_n_f32(params.mul[0]), add0 = vdupq_n_f32(params.add[0]);
+            float32x4_t mul1 = vdupq_n_f32(params.mul[1]), add1 = vdupq_n_f32(params.add[1]);
+            float32x4_t mul2 = vdupq_n_f32(params.mul[2]), add2 = vdupq_n_f32(params.add[2]);
+            int8_t q[3][16];
+            for (; w + 16 <= width; w += 16)
+            {
+                uint8x16x3_t px = vld3q_u8(src_row + w * 3);
+                vst1q_s8(q[0], quantize16(px.val[0], mul0, add0));
+                vst1q_s8(q[1], quantize16(px.val[1], mul1, add1));
+                vst1q_s8(q[2], quantize16(px.val[2], mul2, add2));
+                for (int i = 0; i < 16; i++)
+                {
+                    size_t offset = static_cast<size_t>(w + i) * c2;
+                    dst_rows[0][offset] = q[0][i];
+                    dst_rows[1][offset] = q[1][i];
+                    dst_rows[2][offset] = q[2][i];
+                }
+            }
+        }
+        else if (channels == 1)
+        {
+            float32x4_t mul0 = vdupq_n_f32(params.mul[0]), add0 = vdupq_n_f32(params.add[0]);
+            int8_t q[16];
+            for (; w + 16 <= width; w += 16)
+            {
+                int8x16_t v = quantize16(vld1q_u8(src_row + w), mul0, add0);
+                if (c2 == 1)
+                {
+                    vst1q_s8(dst_rows[0] + w, v);
+                    continue;
+                }
+                vst1q_s8(q, v);
+                for (int i = 0; i < 16; i++)
+                {
+                    dst_rows[0][static_cast<size_t>(w + i) * c2] = q[i];
+                }
+            }
+        }
+#endif
+
+        // 标量尾部 / 参考实现
+        for (int c = 0; c < channels; c++)
+        {
+            const int8_t* lut = params.lut[c];
+            for (int x = w; x < width; x++)
+            {
+                dst_rows[c][static_cast<size_t>(x) * c2] = lut[src_row[x * channels + c]];
+            }
+        }
+    }
+}
+
+// ===== 标量参考实现 =====
+
+namespace reference
+{
+
+void dequantizeI8ToF32(const int8_t* src, size_t count, int32_t zp, float scale, float* dst)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = (static_cast<float>(src[i]) - static_cast<float>(zp)) * scale;
+    }
+}
+
+void dequantizeU8ToF32(const uint8_t* src, size_t count, int32_t zp, float scale, float* dst)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = (static_cast<float>(src[i]) - static_cast<float>(zp)) * scale;
+    }
+}
+
+void convertF16ToF32(const uint16_t* src, size_t count, float* dst)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = static_cast<float>(rknpu2::float16::fromBits(src[i]));
+    }
+}
+
+}  // namespace reference
+
+// ===== SIMD实现 =====
+
+void dequantizeI8ToF32(const int8_t* src, size_t count, int32_t zp, float scale, float* dst)
+{
+    size_t i = 0;
+    // (x - zp) * scale 展开为 x * scale + bias
+    const float bias = -static_cast<float>(zp) * scale;
+#if defined(RKNN_CPP_USE_NEON)
+    float32x4_t vscale = vdupq_n_f32(scale);
+    float32x4_t vbias = vdupq_n_f32(bias);
+    for (; i + 16 <= count; i += 16)
+    {
+        int8x16_t x = vld1q_s8(src + i);
+        int16x8_t lo = vmovl_s8(vget_low_s8(x));
+        int16x8_t hi = vmovl_s8(vget_high_s8(x));
+        vst1q_f32(dst + i, vfmaq_f32(vbias, vcvtq_f32_s32(vmovl_s16(vget_low_s16(lo))), vscale));
+        vst1q_f32(dst + i + 4, vfmaq_f32(vbias, vcvtq_f32_s32(vmovl_s16(vget_high_s16(lo))), vscale));
+        vst1q_f32(dst + i + 8, vfmaq_f32(vbias, vcvtq_f32_s32(vmovl_s16(vget_low_s16(hi))), vscale));
+        vst1q_f32(dst + i + 12, vfmaq_f32(vbias, vcvtq_f32_s32(vmovl_s16(vget_high_s16(hi))), vscale));
+    }
+#elif defined(__AVX2__)
+    __m256 vscale = _mm256_set1_ps(scale);
+    __m256 vbias = _mm256_set1_ps(bias);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(x));
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(f, vscale), vbias));
+    }
+#elif defined(RKNN_CPP_USE_SSE)
+    __m128 vscale = _mm_set1_ps(scale);
+    __m128 vbias = _mm_set1_ps(bias);
+    for (; i + 16 <= count; i += 16)
+    {
+        // SSE2没有符号扩展指令，用自身交织后算术右移实现
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+        __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8);
+        __m128i v[4] = {_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16), _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16),
+                        _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16), _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16)};
+        for (int k = 0; k < 4; k++)
+        {
+            _mm_storeu_ps(dst + i + 4 * k, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v[k]), vscale), vbias));
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        dst[i] = static_cast<float>(src[i]) * scale + bias;
+    }
+}
+
+void dequantizeU8ToF32(const uint8_t* src, size_t count, int32_t zp, float scale, float* dst)
+{
+    size_t i = 0;
+    const float bias = -static_cast<float>(zp) * scale;
+#if defined(RKNN_CPP_USE_NEON)
+    float32x4_t vscale = vdupq_n_f32(scale);
+    float32x4_t vbias = vdupq_n_f32(bias);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16_t x = vld1q_u8(src + i);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(x));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(x));
+        vst1q_f32(dst + i, vfmaq_f32(vbias, vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), vscale));
+        vst1q_f32(dst + i + 4, vfmaq_f32(vbias, vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), vscale));
+        vst1q_f32(dst + i + 8, vfmaq_f32(vbias, vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), vscale));
+        vst1q_f32(dst + i + 12, vfmaq_f32(vbias, vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), vscale));
+    }
+#elif defined(__AVX2__)
+    __m256 vscale = _mm256_set1_ps(scale);
+    __m256 vbias = _mm256_set1_ps(bias);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(x));
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(f, vscale), vbias));
+    }
+#elif defined(RKNN_CPP_USE_SSE)
+    __m128 vscale = _mm_set1_ps(scale);
+    __m128 vbias = _mm_set1_ps(bias);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i lo = _mm_unpacklo_epi8(x, zero);
+        __m128i hi = _mm_unpackhi_epi8(x, zero);
+        __m128i v[4] = {_mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero), _mm_unpacklo_epi16(hi, zero),
+                        _mm_unpackhi_epi16(hi, zero)};
+        for (int k = 0; k < 4; k++)
+        {
+            _mm_storeu_ps(dst + i + 4 * k, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v[k]), vscale), vbias));
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        dst[i] = static_cast<float>(src[i]) * scale + bias;
+    }
+}
+
+void convertF16ToF32(const uint16_t* src, size_t count, float* dst)
+{
+    size_t i = 0;
+#if defined(RKNN_CPP_USE_NEON)
+    for (; i + 8 <= count; i += 8)
+    {
+        float16x8_t h = vreinterpretq_f16_u16(vld1q_u16(src + i));
+        vst1q_f32(dst + i, vcvt_f32_f16(vget_low_f16(h)));
+        vst1q_f32(dst + i + 4, vcvt_high_f32_f16(h));
+    }
+#elif defined(__F16C__)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    reference::convertF16ToF32(src + i, count - i, dst + i);
+}
+
+// 跨步访问无法连续加载，逐个取数后交给连续内核批量转换
+template <typename T>
+static inline void gatherStrided(const T* src, size_t stride, size_t count, T* tmp)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        tmp[i] = src[i * stride];
+    }
+}
+
+static constexpr size_t kGatherChunk = 64;
+
+void gatherI8ToF32(const int8_t* src, size_t stride, size_t count, int32_t zp, float scale, float* dst)
+{
+    int8_t tmp[kGatherChunk];
+    for (size_t i = 0; i < count; i += kGatherChunk)
+    {
+        size_t n = std::min(kGatherChunk, count - i);
+        gatherStrided(src + i * stride, stride, n, tmp);
+        dequantizeI8ToF32(tmp, n, zp, scale, dst + i);
+    }
+}
+
+void gatherU8ToF32(const uint8_t* src, size_t stride, size_t count, int32_t zp, float scale, float* dst)
+{
+    uint8_t tmp[kGatherChunk];
+    for (size_t i = 0; i < count; i += kGatherChunk)
+    {
+        size_t n = std::min(kGatherChunk, count - i);
+        gatherStrided(src + i * stride, stride, n, tmp);
+        dequantizeU8ToF32(tmp, n, zp, scale, dst + i);
+    }
+}
+
+void gatherF16ToF32(const uint16_t* src, size_t stride, size_t count, float* dst)
+{
+    uint16_t tmp[kGatherChunk];
+    for (size_t i = 0; i < count; i += kGatherChunk)
+    {
+        size_t n = std::min(kGatherChunk, count - i);
+        gatherStrided(src + i * stride, stride, n, tmp);
+        convertF16ToF32(tmp, n, dst + i);
+    }
+}
+
+void gatherF32(const float* src, size_t stride, size_t count, float* dst)
+{
+    gatherStrided(src, stride, count, dst);
+}
+
+}  // namespace rknn_cpp
@@ -0,0 +1,151 @@
+#include "rknn_cpp/utils/tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace rknn_cpp
+{
+
+std::atomic<bool> Tracer::enabled_{false};
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::ThreadBuffer* Tracer::threadBuffer()
+{
+    // 每个线程首次记录时注册自己的缓冲区，之后直接使用缓存的指针
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->tid = static_cast<uint32_t>(syscall(SYS_gettid));
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.push_back(created);
+        buffer = created.get();
+    }
+    return buffer;
+}
+
+void Tracer::record(const char* name, uint64_t start_us, uint64_t end_us)
+{
+    ThreadBuffer* buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    if (buffer->events.size() < kMaxEventsPerThread)
+    {
+        buffer->events.push_back({name, start_us, end_us - start_us});
+    }
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& buffer : buffers_)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->events.clear();
+    }
+}
+
+void Tracer::start()
+{
+    clear();
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::captureFrames(int frame_count, const std::string& path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capture_path_ = path;
+    }
+    frames_remaining_.store(frame_count, std::memory_order_relaxed);
+    start();
+    std::cout << "[TRACE] Capturing " << frame_count << " frames to " << path << std::endl;
+}
+
+void Tracer::frameEnd()
+{
+    if (!isEnabled() || frames_remaining_.load(std::memory_order_relaxed) <= 0)
+    {
+        return;
+    }
+    // 只有把计数减到0的线程负责写出
+    if (frames_remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        stop();
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            path = capture_path_;
+        }
+        dumpChromeTrace(path);
+    }
+}
+
+static void writeJsonString(FILE* file, const char* text)
+{
+    fputc('"', file);
+    for (const char* p = text; *p != '\0'; p++)
+    {
+        if (*p == '"' || *p == '\\')
+        {
+            fputc('\\', file);
+        }
+        fputc(*p, file);
+    }
+    fputc('"', file);
+}
+
+bool Tracer::dumpChromeTrace(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        std::cerr << "Cannot open trace file: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers = buffers_;
+    }
+
+    const int pid = static_cast<int>(getpid());
+    size_t total = 0;
+    bool first = true;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (const auto& buffer : buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        for (const auto& event : buffer->events)
+        {
+            fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+            writeJsonString(file, event.name);
+            fprintf(file, ",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":%d,\"tid\":%u}",
+                    static_cast<unsigned long long>(event.start_us),
+                    static_cast<unsigned long long>(event.duration_us), pid, buffer->tid);
+            first = false;
+        }
+        total += buffer->events.size();
+    }
+    fprintf(file, "\n]}\n");
+    bool ok = ferror(file) == 0;
+    fclose(file);
+
+    std::cout << "[TRACE] Wrote " << total << " spans from " << buffers.size() << " threads to " << path
+              << std::endl;
+    return ok;
+}
+
+}  // namespace rknn_cpp
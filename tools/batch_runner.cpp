@@ -0,0 +1,164 @@
+#include "rknn_cpp.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace rknn_cpp;
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " --model <file.rknn> --input <dir|manifest> --output <file> [options]\n"
+              << "  --type <resnet|yolov3|custom>  model wrapper (default: resnet)\n"
+              << "  --format <jsonl|binary>        output format (default: jsonl)\n"
+              << "  --contexts <n>                 model contexts running in parallel (default: 1)\n"
+              << "  --decode-threads <n>           decode thread pool size (default: 2)\n"
+              << "  --prefetch <n>                 decoded images buffered ahead (default: 8)\n"
+              << "  --checkpoint-interval <n>      results between checkpoints (default: 100)\n"
+              << "  --no-resume                    ignore an existing checkpoint and start over\n"
+              << "  --set <key=value>              extra ModelConfig entry, may be repeated\n";
+}
+
+static std::unique_ptr<IModel> createModelByType(const std::string& type)
+{
+    if (type == "resnet")
+    {
+        return createResNetModel();
+    }
+    if (type == "yolov3")
+    {
+        return createYoloV3Model();
+    }
+    if (type == "custom")
+    {
+        return createCustomModel();
+    }
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    std::string type = "resnet";
+    std::string input_path;
+    int contexts = 1;
+    BatchRunnerConfig runner_config;
+    ModelConfig config;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--model" && has_value)
+        {
+            config["model_path"] = argv[++i];
+        }
+        else if (arg == "--type" && has_value)
+        {
+            type = argv[++i];
+        }
+        else if (arg == "--input" && has_value)
+        {
+            input_path = argv[++i];
+        }
+        else if (arg == "--output" && has_value)
+        {
+            runner_config.output_path = argv[++i];
+        }
+        else if (arg == "--format" && has_value)
+        {
+            std::string format = argv[++i];
+            if (format != "jsonl" && format != "binary")
+            {
+                std::cerr << "Unknown output format: " << format << std::endl;
+                return -1;
+            }
+            runner_config.format = format == "binary" ? ResultFormat::BINARY : ResultFormat::JSONL;
+        }
+        else if (arg == "--contexts" && has_value)
+        {
+            contexts = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--decode-threads" && has_value)
+        {
+            runner_config.decode_threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--prefetch" && has_value)
+        {
+            runner_config.prefetch = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--checkpoint-interval" && has_value)
+        {
+            runner_config.checkpoint_interval = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--no-resume")
+        {
+            runner_config.resume = false;
+        }
+        else if (arg == "--set" && has_value)
+        {
+            std::string entry = argv[++i];
+            size_t pos = entry.find('=');
+            if (pos == std::string::npos)
+            {
+                std::cerr << "Invalid --set entry: " << entry << std::endl;
+                return -1;
+            }
+            config[entry.substr(0, pos)] = entry.substr(pos + 1);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : -1;
+        }
+    }
+
+    if (config.find("model_path") == config.end() || input_path.empty() || runner_config.output_path.empty())
+    {
+        printUsage(argv[0]);
+        return -1;
+    }
+
+    std::vector<std::string> inputs = BatchRunner::listInputs(input_path);
+    if (inputs.empty())
+    {
+        std::cerr << "No images found in " << input_path << std::endl;
+        return -1;
+    }
+
+    // 并行初始化全部上下文
+    std::vector<std::unique_ptr<IModel>> models;
+    ModelGroupLoader loader;
+    for (int i = 0; i < contexts; i++)
+    {
+        models.push_back(createModelByType(type));
+        if (!models.back())
+        {
+            std::cerr << "Unknown model type: " << type << std::endl;
+            return -1;
+        }
+        loader.add("context" + std::to_string(i), models.back().get(), config);
+    }
+    loader.start();
+    if (!loader.waitAll())
+    {
+        std::cerr << "Failed to initialize model contexts" << std::endl;
+        loader.printSummary();
+        return -1;
+    }
+
+    std::vector<IModel*> contexts_ptr;
+    for (auto& model : models)
+    {
+        contexts_ptr.push_back(model.get());
+    }
+    BatchRunner runner(contexts_ptr, runner_config);
+    bool ok = runner.run(inputs);
+
+    for (auto& model : models)
+    {
+        model->release();
+    }
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,270 @@
+#include "rknn_cpp.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace rknn_cpp;
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " --model <file.rknn> [options]\n"
+              << "  --type <resnet|yolov3|custom>  model wrapper (default: yolov3)\n"
+              << "  --image <file>                 input image (default: gray frame at model size)\n"
+              << "  --runs <n>                     timed runs (default: 100)\n"
+              << "  --warmup <n>                   untimed warmup runs (default: 10)\n"
+              << "  --profile                      per-layer profiling via RKNN_QUERY_PERF_DETAIL\n"
+              << "  --top <n>                      layers to print with --profile (default: 20, 0 = all)\n"
+              << "  --compare-sram                 run once with DRAM and once with enable_sram, report the delta\n"
+              << "  --set <key=value>              extra ModelConfig entry, may be repeated\n";
+}
+
+static std::unique_ptr<IModel> createModelByType(const std::string& type)
+{
+    if (type == "resnet")
+    {
+        return createResNetModel();
+    }
+    if (type == "yolov3")
+    {
+        return createYoloV3Model();
+    }
+    if (type == "custom")
+    {
+        return createCustomModel();
+    }
+    return nullptr;
+}
+
+struct BenchOptions
+{
+    std::string type = "yolov3";
+    std::string image_path;
+    int runs = 100;
+    int warmup = 10;
+    size_t top_n = 20;
+    bool profile = false;
+};
+
+struct BenchResult
+{
+    std::vector<double> latencies;  // 升序
+    int failures = 0;
+    double mean = 0.0;
+    ModelMemoryUsage memory;
+};
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static bool runBenchmark(const BenchOptions& options, const ModelConfig& config, BenchResult& bench)
+{
+    auto model = createModelByType(options.type);
+    if (!model)
+    {
+        std::cerr << "Unknown model type: " << options.type << std::endl;
+        return false;
+    }
+    if (!model->initialize(config))
+    {
+        std::cerr << "Failed to initialize model" << std::endl;
+        return false;
+    }
+
+    cv::Mat image;
+    if (!options.image_path.empty())
+    {
+        image = cv::imread(options.image_path);
+        if (image.empty())
+        {
+            std::cerr << "Failed to read image: " << options.image_path << std::endl;
+            model->release();
+            return false;
+        }
+    }
+    else
+    {
+        image = cv::Mat(model->getModelHeight(), model->getModelWidth(), CV_8UC3, cv::Scalar(114, 114, 114));
+    }
+
+    for (int i = 0; i < options.warmup; i++)
+    {
+        model->predict(image);
+    }
+    model->resetLayerProfile();
+
+    bench.latencies.clear();
+    bench.latencies.reserve(options.runs);
+    bench.failures = 0;
+    for (int i = 0; i < options.runs; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        InferenceResult result = model->predict(image);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (!result.is_success)
+        {
+            bench.failures++;
+            continue;
+        }
+        bench.latencies.push_back(elapsed.count());
+    }
+
+    std::vector<double>& latencies = bench.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0.0;
+    for (double latency : latencies)
+    {
+        total += latency;
+    }
+    bench.mean = latencies.empty() ? 0.0 : total / latencies.size();
+    bench.memory = model->getMemoryUsage();
+
+    std::cout << "\n" << std::string(60, '=') << std::endl;
+    std::cout << "                  BENCHMARK RESULT" << std::endl;
+    std::cout << std::string(60, '=') << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "[BENCH] Model   : " << model->getModelName() << " (" << config.at("model_path") << ")" << std::endl;
+    std::cout << "[BENCH] Runs    : " << latencies.size() << " ok, " << bench.failures << " failed, "
+              << options.warmup << " warmup" << std::endl;
+    std::cout << "[BENCH] Mean    : " << bench.mean << " ms (" << (bench.mean > 0.0 ? 1000.0 / bench.mean : 0.0)
+              << " FPS)" << std::endl;
+    std::cout << "[BENCH] Min/Max : " << (latencies.empty() ? 0.0 : latencies.front()) << " / "
+              << (latencies.empty() ? 0.0 : latencies.back()) << " ms" << std::endl;
+    std::cout << "[BENCH] P50/P90/P99: " << percentile(latencies, 0.50) << " / " << percentile(latencies, 0.90)
+              << " / " << percentile(latencies, 0.99) << " ms" << std::endl;
+    std::cout << "[BENCH] Memory  : " << bench.memory.total() / 1048576.0 << " MB DRAM, "
+              << (bench.memory.sram_bytes >> 10) << " KB SRAM" << std::endl;
+
+    if (options.profile)
+    {
+        std::vector<LayerProfile> layers = model->getLayerProfile();
+        std::cout << "\n[PROFILE] Per-layer time over " << latencies.size() << " runs (sorted by total time)"
+                  << std::endl;
+        if (layers.empty())
+        {
+            std::cout << "[PROFILE] No layer data, runtime returned no RKNN_QUERY_PERF_DETAIL table" << std::endl;
+        }
+        else
+        {
+            std::cout << LayerProfiler::formatTable(layers, options.top_n);
+        }
+    }
+
+    model->release();
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    bool compare_sram = false;
+    ModelConfig config;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--model" && has_value)
+        {
+            config["model_path"] = argv[++i];
+        }
+        else if (arg == "--type" && has_value)
+        {
+            options.type = argv[++i];
+        }
+        else if (arg == "--image" && has_value)
+        {
+            options.image_path = argv[++i];
+        }
+        else if (arg == "--runs" && has_value)
+        {
+            options.runs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--warmup" && has_value)
+        {
+            options.warmup = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--top" && has_value)
+        {
+            options.top_n = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        }
+        else if (arg == "--profile")
+        {
+            options.profile = true;
+        }
+        else if (arg == "--compare-sram")
+        {
+            compare_sram = true;
+        }
+        else if (arg == "--set" && has_value)
+        {
+            std::string entry = argv[++i];
+            size_t pos = entry.find('=');
+            if (pos == std::string::npos)
+            {
+                std::cerr << "Invalid --set entry: " << entry << std::endl;
+                return -1;
+            }
+            config[entry.substr(0, pos)] = entry.substr(pos + 1);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : -1;
+        }
+    }
+
+    if (config.find("model_path") == config.end())
+    {
+        printUsage(argv[0]);
+        return -1;
+    }
+    if (options.profile)
+    {
+        config["enable_profiling"] = "1";
+    }
+
+    if (!compare_sram)
+    {
+        BenchResult bench;
+        if (!runBenchmark(options, config, bench))
+        {
+            return -1;
+        }
+        return bench.failures == 0 ? 0 : 1;
+    }
+
+    // 同一配置分别以DRAM与SRAM放置中间层各运行一次
+    BenchResult dram;
+    BenchResult sram;
+    config["enable_sram"] = "0";
+    if (!runBenchmark(options, config, dram))
+    {
+        return -1;
+    }
+    config["enable_sram"] = "1";
+    if (!runBenchmark(options, config, sram))
+    {
+        return -1;
+    }
+
+    double delta = sram.mean - dram.mean;
+    std::cout << "\n[SRAM] Internal memory in SRAM: " << (sram.memory.sram_bytes >> 10) << " KB" << std::endl;
+    std::cout << "[SRAM] Mean latency  DRAM: " << dram.mean << " ms, SRAM: " << sram.mean << " ms, delta: "
+              << std::showpos << delta << std::noshowpos << " ms ("
+              << (dram.mean > 0.0 ? delta * 100.0 / dram.mean : 0.0) << "%)" << std::endl;
+    std::cout << "[SRAM] P99 latency   DRAM: " << percentile(dram.latencies, 0.99)
+              << " ms, SRAM: " << percentile(sram.latencies, 0.99) << " ms" << std::endl;
+    return dram.failures == 0 && sram.failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+#include "rknn_cpp.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace rknn_cpp;
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " --model <name=type:file.rknn[:contexts]> [--model ...] [options]\n"
+              << "  type: resnet|yolov3|custom; clients select the model by name\n"
+              << "  --socket <path>           UNIX socket path (default: " << kIpcDefaultSocket << ")\n"
+              << "  --max-batch <n>           requests a context takes per wakeup (default: 4)\n"
+              << "  --batch-timeout-us <n>    wait to fill a batch (default: 0)\n"
+              << "  --quota-inflight <n>      concurrent requests per client process, 0 = unlimited\n"
+              << "  --quota-rps <n>           requests per second per client process, 0 = unlimited\n"
+              << "  --set <key=value>         extra ModelConfig entry for all models, may be repeated\n";
+}
+
+static std::unique_ptr<IModel> createModelByType(const std::string& type)
+{
+    if (type == "resnet")
+    {
+        return createResNetModel();
+    }
+    if (type == "yolov3")
+    {
+        return createYoloV3Model();
+    }
+    if (type == "custom")
+    {
+        return createCustomModel();
+    }
+    return nullptr;
+}
+
+struct ModelSpec
+{
+    std::string name;
+    std::string type;
+    std::string path;
+    int contexts = 1;
+};
+
+// name=type:path[:contexts]
+static bool parseModelSpec(const std::string& text, ModelSpec& spec)
+{
+    size_t eq = text.find('=');
+    size_t colon = text.find(':', eq == std::string::npos ? 0 : eq);
+    if (eq == std::string::npos || eq == 0 || colon == std::string::npos)
+    {
+        return false;
+    }
+    spec.name = text.substr(0, eq);
+    spec.type = text.substr(eq + 1, colon - eq - 1);
+    spec.path = text.substr(colon + 1);
+    size_t last = spec.path.rfind(':');
+    if (last != std::string::npos && last + 1 < spec.path.size() &&
+        spec.path.find_first_not_of("0123456789", last + 1) == std::string::npos)
+    {
+        spec.contexts = std::max(1, std::atoi(spec.path.c_str() + last + 1));
+        spec.path.resize(last);
+    }
+    return !spec.path.empty();
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<ModelSpec> specs;
+    InferenceServerConfig server_config;
+    ModelConfig config;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--model" && has_value)
+        {
+            ModelSpec spec;
+            if (!parseModelSpec(argv[++i], spec))
+            {
+                std::cerr << "Invalid --model entry: " << argv[i] << std::endl;
+                return -1;
+            }
+            specs.push_back(spec);
+        }
+        else if (arg == "--socket" && has_value)
+        {
+            server_config.socket_path = argv[++i];
+        }
+        else if (arg == "--max-batch" && has_value)
+        {
+            server_config.max_batch = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--batch-timeout-us" && has_value)
+        {
+            server_config.batch_timeout_us = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--quota-inflight" && has_value)
+        {
+            server_config.max_inflight = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--quota-rps" && has_value)
+        {
+            server_config.max_rps = std::max(0.0, std::atof(argv[++i]));
+        }
+        else if (arg == "--set" && has_value)
+        {
+            std::string entry = argv[++i];
+            size_t pos = entry.find('=');
+            if (pos == std::string::npos)
+            {
+                std::cerr << "Invalid --set entry: " << entry << std::endl;
+                return -1;
+            }
+            config[entry.substr(0, pos)] = entry.substr(pos + 1);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : -1;
+        }
+    }
+
+    if (specs.empty())
+    {
+        printUsage(argv[0]);
+        return -1;
+    }
+
+    // 并行初始化全部模型的全部上下文
+    std::map<std::string, std::vector<std::unique_ptr<IModel>>> models;
+    ModelGroupLoader loader;
+    for (const auto& spec : specs)
+    {
+        ModelConfig model_config = config;
+        model_config["model_path"] = spec.path;
+        auto& contexts = models[spec.name];
+        for (int i = 0; i < spec.contexts; i++)
+        {
+            contexts.push_back(createModelByType(spec.type));
+            if (!contexts.back())
+            {
+                std::cerr << "Unknown model type: " << spec.type << std::endl;
+                return -1;
+            }
+            loader.add(spec.name + "#" + std::to_string(i), contexts.back().get(), model_config);
+        }
+    }
+    loader.start();
+    if (!loader.waitAll())
+    {
+        std::cerr << "Failed to initialize models" << std::endl;
+        loader.printSummary();
+        return -1;
+    }
+
+    // 服务线程继承屏蔽的信号，由主线程sigwait处理退出
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    InferenceServer server(server_config);
+    for (auto& item : models)
+    {
+        if (!server.addModel(item.first, std::move(item.second)))
+        {
+            return -1;
+        }
+    }
+    if (!server.start())
+    {
+        return -1;
+    }
+
+    int signal_number = 0;
+    sigwait(&signals, &signal_number);
+    std::cout << "Received signal " << signal_number << ", shutting down" << std::endl;
+    server.stop();
+    server.printSummary();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "rknn_cpp.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace rknn_cpp;
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options] <file.rknn>...\n"
+              << "  --no-cache        always query the runtime, ignore <file>.rknn.info\n"
+              << "  --budget-mb <n>   check that the models fit in n MB together (exit code 2 if not)\n";
+}
+
+int main(int argc, char** argv)
+{
+    bool use_cache = true;
+    int budget_mb = 0;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--no-cache")
+        {
+            use_cache = false;
+        }
+        else if (arg == "--budget-mb" && i + 1 < argc)
+        {
+            budget_mb = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            printUsage(argv[0]);
+            return -1;
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty())
+    {
+        printUsage(argv[0]);
+        return -1;
+    }
+
+    uint64_t total_bytes = 0;
+    bool all_valid = true;
+    for (const auto& path : paths)
+    {
+        ModelInfo info = inspectModel(path, use_cache);
+        printModelInfo(info);
+        all_valid = all_valid && info.valid;
+        total_bytes += info.estimatedBytes();
+    }
+    if (!all_valid)
+    {
+        return -1;
+    }
+
+    // 准入检查：全部模型同时加载所需的估计内存
+    if (budget_mb > 0)
+    {
+        uint64_t budget_bytes = static_cast<uint64_t>(budget_mb) << 20;
+        bool fits = total_bytes <= budget_bytes;
+        std::cout << "[BUDGET] " << (total_bytes >> 20) << " MB required, budget " << budget_mb << " MB: "
+                  << (fits ? "fits" : "exceeds") << std::endl;
+        return fits ? 0 : 2;
+    }
+    return 0;
+}